@@ -3,6 +3,8 @@
 #include <map>
 #include <set>
 #include <random>
+#include <algorithm>
+#include <array>
 //V23
 class Grammar {
 private:
@@ -11,6 +13,45 @@ private:
     std::map<char, std::vector<std::string>> P;
     char startSymbol = 'S';
     std::vector<std::string> generatedStrings;
+    std::mt19937 rng{std::random_device{}()};
+    // The rules of each nonterminal by character, null for terminals.
+    std::array<const std::vector<std::string>*, 256> rulesOf{};
+    std::vector<char> stack;
+    // counts[A][n]: how many words of length n nonterminal A derives.
+    std::map<char, std::vector<double>> counts;
+
+    // Every rule is a terminal, optionally followed by a nonterminal, and no
+    // two rules of a nonterminal start with the same terminal. Each word then
+    // has a single derivation, so counting derivations counts words.
+    void countWords(int maxLength) {
+        if (!counts.empty() && static_cast<int>(counts[startSymbol].size()) > maxLength) return;
+        for (char n : VN) counts[n].assign(maxLength + 1, 0.0);
+        for (int length = 1; length <= maxLength; ++length) {
+            for (char n : VN) {
+                for (const auto& rule : P[n]) counts[n][length] += ruleCount(rule, length);
+            }
+        }
+    }
+
+    double ruleCount(const std::string& rule, int length) {
+        if (rule.size() == 1) return length == 1 ? 1.0 : 0.0;
+        return counts[rule[1]][length - 1];
+    }
+
+    // Lists the words of at most `left` more symbols, after `prefix`, that
+    // nonterminal n derives. Rules are tried in order of their terminal, and
+    // a word ending here before longer ones, so the output is sorted.
+    void enumerateFrom(char n, std::string& prefix, int left, std::vector<std::string>& out) {
+        std::vector<std::string> rules = P[n];
+        std::sort(rules.begin(), rules.end());
+        for (const auto& rule : rules) {
+            if (left < static_cast<int>(rule.size() == 1 ? 1 : 2)) continue;
+            prefix.push_back(rule[0]);
+            if (rule.size() == 1) out.push_back(prefix);
+            else enumerateFrom(rule[1], prefix, left - 1, out);
+            prefix.pop_back();
+        }
+    }
 
 public:
     // Initialize the grammar rules
@@ -18,28 +59,26 @@ public:
         P['S'] = {"aB"};
         P['B'] = {"aC", "bB"};
         P['C'] = {"bB", "c", "aS"};
+        for (char n : VN) rulesOf[static_cast<unsigned char>(n)] = &P[n];
     }
 
+    // Derives leftmost-first with an explicit stack of the symbols still to
+    // expand, top = leftmost, appending terminals to the word as they come
+    // up, so a word takes time linear in its length.
     std::string generateString() {
-        std::string current = std::string(1, startSymbol);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-
-        while (true) {
-            bool expanded = false;
-            for (size_t i = 0; i < current.size(); ++i) {
-                char c = current[i];
-                if (VN.find(c) != VN.end()) {  // If it's a non-terminal
-                    auto& rules = P[c];
-                    std::uniform_int_distribution<> distrib(0, rules.size() - 1);
-                    std::string replacement = rules[distrib(gen)];
-
-                    current.replace(i, 1, replacement);
-                    expanded = true;
-                    break;
-                }
+        std::string current;
+        stack.assign(1, startSymbol);
+        while (!stack.empty()) {
+            char c = stack.back();
+            stack.pop_back();
+            const std::vector<std::string>* rules = rulesOf[static_cast<unsigned char>(c)];
+            if (rules == nullptr) {  // A terminal
+                current += c;
+                continue;
             }
-            if (!expanded) break;
+            std::uniform_int_distribution<> distrib(0, rules->size() - 1);
+            const std::string& replacement = (*rules)[distrib(rng)];
+            stack.insert(stack.end(), replacement.rbegin(), replacement.rend());
         }
         generatedStrings.push_back(current);
         return current;
@@ -51,6 +90,46 @@ public:
         }
     }
 
+    // The number of words of exactly this length the grammar generates.
+    double countStrings(int length) {
+        if (length < 0) return 0;
+        countWords(length);
+        return counts[startSymbol][length];
+    }
+
+    // A word drawn uniformly among all words of this length, unlike
+    // generateString, which favours short words. Empty if there is none.
+    std::string generateStringOfLength(int length) {
+        if (countStrings(length) == 0) return "";
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::string word;
+        char current = startSymbol;
+        for (int left = length; left > 0; --left) {
+            // Picks a rule in proportion to the words it leads to.
+            double pick = unit(rng) * counts[current][left];
+            const std::string* chosen = nullptr;
+            for (const auto& rule : P[current]) {
+                double ways = ruleCount(rule, left);
+                if (ways == 0) continue;
+                chosen = &rule;
+                if (pick < ways) break;
+                pick -= ways;
+            }
+            word += (*chosen)[0];
+            if (chosen->size() == 1) break;
+            current = (*chosen)[1];
+        }
+        return word;
+    }
+
+    // Every word of at most maxLength symbols, in lexicographic order.
+    std::vector<std::string> enumerateStrings(int maxLength) {
+        std::vector<std::string> words;
+        std::string prefix;
+        enumerateFrom(startSymbol, prefix, maxLength, words);
+        return words;
+    }
+
     const std::vector<std::string>& getGeneratedStrings() const {
         return generatedStrings;
     }
@@ -76,12 +155,13 @@ public:
         transitions[{'C', 'a'}] = 'S';  
     }
        
-    bool validateString(const std::string& input) {
+    bool validateString(const std::string& input) const {
         char currentState = startState;
 
         for (char symbol : input) {
-            if (transitions.find({currentState, symbol}) != transitions.end()) {
-                currentState = transitions[{currentState, symbol}];
+            auto it = transitions.find({currentState, symbol});
+            if (it != transitions.end()) {
+                currentState = it->second;
             } else {
                 return false;
             }
@@ -110,5 +190,15 @@ int main() {
         }
     }
 
+    std::cout << "\nUniform strings of length 8 (" << grammar.countStrings(8) << " in all):\n";
+    for (int i = 0; i < 5; i++) {
+        std::cout << grammar.generateStringOfLength(8) << "\n";
+    }
+
+    std::cout << "\nAll strings up to length 5:\n";
+    for (const auto& str : grammar.enumerateStrings(5)) {
+        std::cout << str << "\n";
+    }
+
     return 0;
 }
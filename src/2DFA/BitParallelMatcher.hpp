@@ -0,0 +1,95 @@
+#ifndef BIT_PARALLEL_MATCHER_H
+#define BIT_PARALLEL_MATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomaton.hpp"
+
+// Compiled form of a FiniteAutomaton for membership tests. The set of active
+// states is a bitset over the automaton's state ids, and each input character
+// ORs together the precomputed successor masks of the active states. Nothing
+// is allocated per character.
+class BitParallelMatcher {
+public:
+    explicit BitParallelMatcher(const FiniteAutomaton& automaton) {
+        stateCount = automaton.StateCount();
+        words = (stateCount + 63) / 64;
+        symbolCount = static_cast<int>(automaton.SymbolCount());
+        for (int c = 0; c < 256; ++c) {
+            FiniteAutomaton::SymbolId symbol = automaton.SymbolOf(static_cast<char>(c));
+            symbolOf[c] = symbol == FiniteAutomaton::None ? -1 : static_cast<int>(symbol);
+        }
+
+        successors.assign(static_cast<size_t>(symbolCount) * stateCount * words, 0);
+        startMask.assign(words, 0);
+        finalMask.assign(words, 0);
+        SetBit(startMask.data(), automaton.Start());
+        for (uint32_t state = 0; state < stateCount; ++state) {
+            if (automaton.IsFinal(state)) SetBit(finalMask.data(), state);
+            for (int symbol = 0; symbol < symbolCount; ++symbol)
+                for (uint32_t target : automaton.Successors(state, symbol)) SetBit(Row(symbol, state), target);
+        }
+    }
+
+    // Same answer as FiniteAutomaton::StringBelongsToLanguage.
+    bool Accepts(std::string_view input) const {
+        uint64_t inlineBuffer[2 * InlineWords];
+        std::vector<uint64_t> heapBuffer;
+        uint64_t* current = inlineBuffer;
+        if (words > InlineWords) {
+            heapBuffer.resize(2 * words);
+            current = heapBuffer.data();
+        }
+        uint64_t* next = current + words;
+        std::copy(startMask.begin(), startMask.end(), current);
+
+        for (char c : input) {
+            int symbol = symbolOf[static_cast<unsigned char>(c)];
+            if (symbol < 0) return false;
+
+            std::fill(next, next + words, 0);
+            const uint64_t* table = Row(symbol, 0);
+            for (size_t w = 0; w < words; ++w) {
+                for (uint64_t bits = current[w]; bits; bits &= bits - 1) {
+                    const uint64_t* row = table + (w * 64 + CountTrailingZeros(bits)) * words;
+                    for (size_t k = 0; k < words; ++k) next[k] |= row[k];
+                }
+            }
+
+            uint64_t any = 0;
+            for (size_t k = 0; k < words; ++k) any |= next[k];
+            if (!any) return false;
+            std::swap(current, next);
+        }
+
+        for (size_t k = 0; k < words; ++k)
+            if (current[k] & finalMask[k]) return true;
+        return false;
+    }
+
+    size_t StateCount() const { return stateCount; }
+
+private:
+    static constexpr size_t InlineWords = 8;
+
+    size_t stateCount = 0;
+    size_t words = 0;
+    int symbolCount = 0;
+    std::array<int, 256> symbolOf;    // -1: the character labels no transition
+    std::vector<uint64_t> successors; // [symbol][state][word]
+    std::vector<uint64_t> startMask;
+    std::vector<uint64_t> finalMask;
+
+    static void SetBit(uint64_t* mask, uint32_t bit) { mask[bit / 64] |= uint64_t(1) << (bit % 64); }
+
+    uint64_t* Row(int symbol, uint32_t state) {
+        return successors.data() + (static_cast<size_t>(symbol) * stateCount + state) * words;
+    }
+    const uint64_t* Row(int symbol, uint32_t state) const {
+        return successors.data() + (static_cast<size_t>(symbol) * stateCount + state) * words;
+    }
+};
+
+#endif
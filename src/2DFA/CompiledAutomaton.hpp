@@ -0,0 +1,312 @@
+#ifndef COMPILED_AUTOMATON_H
+#define COMPILED_AUTOMATON_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomaton.hpp"
+#include "BitParallelMatcher.hpp"
+#include "ThreadPool.hpp"
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// One bit per input string, set when the string is accepted.
+struct AcceptBitmap {
+    std::vector<uint64_t> words;
+    size_t size = 0;
+
+    bool operator[](size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+
+    size_t Count() const {
+        size_t count = 0;
+        for (uint64_t word : words) {
+            for (; word; word &= word - 1) ++count;
+        }
+        return count;
+    }
+};
+
+struct LineCounts {
+    size_t accepted = 0;
+    size_t rejected = 0;
+};
+
+// Read-only matcher built from a FiniteAutomaton, safe to share between
+// threads. A deterministic automaton becomes a byte-indexed table walk, any
+// other one a BitParallelMatcher.
+class CompiledAutomaton {
+public:
+    explicit CompiledAutomaton(const FiniteAutomaton& automaton) {
+        if (!automaton.IsDeterministic()) {
+            nfa.emplace(automaton);
+            return;
+        }
+
+        // Row 0 is a dead state; automaton state s is row s + 1. The last
+        // column stands for every byte that is not a symbol and leads to the
+        // dead state. Entries hold row offsets rather than row numbers.
+        const size_t symbolCount = automaton.SymbolCount();
+        columns = static_cast<uint32_t>(symbolCount + 1);
+        for (int c = 0; c < 256; ++c) {
+            FiniteAutomaton::SymbolId symbol = automaton.SymbolOf(static_cast<char>(c));
+            byteColumn[c] = symbol == FiniteAutomaton::None ? columns - 1 : symbol;
+        }
+        const size_t rows = automaton.StateCount() + 1;
+        table.assign(rows * columns, 0);
+        accepting.assign(rows, 0);
+        for (FiniteAutomaton::StateId state = 0; state < automaton.StateCount(); ++state) {
+            accepting[state + 1] = automaton.IsFinal(state);
+            for (FiniteAutomaton::SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                FiniteAutomaton::StateId target = automaton.Next(state, symbol);
+                if (target != FiniteAutomaton::None) table[(state + 1) * columns + symbol] = (target + 1) * columns;
+            }
+        }
+        start = (automaton.Start() + 1) * columns;
+    }
+
+    bool Accepts(std::string_view input) const {
+        if (nfa) return nfa->Accepts(input);
+
+        return accepting[Run(start, input) / columns] != 0;
+    }
+
+    // Tests one long input on several threads. The input is cut into chunks
+    // that are run at the same time; the first one from the start state, the
+    // others
+    //   - from every state at once when the DFA has at most EnumerateLimit
+    //     rows, merging runs whose states meet (enumerative), or
+    //   - from the state the start state reaches over the bytes just before
+    //     the chunk (speculative).
+    // The chunk results are then chained in order; a chunk whose guess turns
+    // out wrong is run again from the real state.
+    bool AcceptsParallel(std::string_view input, ThreadPool& pool = ThreadPool::Default(),
+                         size_t chunkSize = size_t(1) << 20) const {
+        chunkSize = std::max<size_t>(chunkSize, 1);
+        if (nfa || pool.Size() == 1 || input.size() <= chunkSize) return Accepts(input);
+
+        const size_t chunks = (input.size() + chunkSize - 1) / chunkSize;
+        const size_t rows = accepting.size();
+        const bool enumerate = rows <= EnumerateLimit;
+        auto chunk = [&](size_t k) { return input.substr(k * chunkSize, chunkSize); };
+        std::vector<std::vector<uint32_t>> maps(enumerate ? chunks : 0);
+        std::vector<uint32_t> guess(chunks, start), guessEnd(chunks);
+        pool.ParallelFor(chunks, 1, [&](size_t first, size_t last) {
+            for (size_t k = first; k < last; ++k) {
+                if (k > 0 && enumerate) {
+                    maps[k] = RunAll(chunk(k));
+                    continue;
+                }
+                if (k > 0) {
+                    size_t lookback = std::min(k * chunkSize, Lookback);
+                    guess[k] = Run(start, input.substr(k * chunkSize - lookback, lookback));
+                }
+                guessEnd[k] = Run(guess[k], chunk(k));
+            }
+        });
+
+        uint32_t state = guessEnd[0];
+        for (size_t k = 1; k < chunks && state != 0; ++k) {
+            if (enumerate) state = maps[k][state / columns];
+            else state = state == guess[k] ? guessEnd[k] : Run(state, chunk(k));
+        }
+        return accepting[state / columns] != 0;
+    }
+
+    // Tests every input, splitting the work over the pool in runs of whole
+    // bitmap words so that no two threads write the same word.
+    AcceptBitmap Accepts(const std::string_view* inputs, size_t count, ThreadPool& pool = ThreadPool::Default()) const {
+        AcceptBitmap result;
+        result.size = count;
+        result.words.assign((count + 63) / 64, 0);
+        pool.ParallelFor(result.words.size(), 64, [&](size_t firstWord, size_t lastWord) {
+            for (size_t w = firstWord; w < lastWord; ++w) {
+                uint64_t bits = 0;
+                size_t end = std::min(count, w * 64 + 64);
+                for (size_t i = w * 64; i < end; ++i) bits |= uint64_t(Accepts(inputs[i])) << (i % 64);
+                result.words[w] = bits;
+            }
+        });
+        return result;
+    }
+
+    AcceptBitmap Accepts(const std::vector<std::string_view>& inputs, ThreadPool& pool = ThreadPool::Default()) const {
+        return Accepts(inputs.data(), inputs.size(), pool);
+    }
+
+    // Tests every line of a file (without its "\n" or "\r\n"), mapping the
+    // file into memory and counting in parallel.
+    LineCounts CountFile(const std::string& path, ThreadPool& pool = ThreadPool::Default()) const {
+        MappedFile file(path);
+        return CountLines(file.Data(), pool);
+    }
+
+    LineCounts CountLines(std::string_view text, ThreadPool& pool = ThreadPool::Default()) const {
+        const size_t chunkSize = 1 << 20;
+        const size_t chunks = (text.size() + chunkSize - 1) / chunkSize;
+        std::vector<LineCounts> counts(chunks);
+        // A chunk counts the lines that start inside it.
+        auto lineStart = [&](size_t offset) {
+            if (offset == 0 || offset >= text.size()) return std::min(offset, text.size());
+            size_t newline = text.find('\n', offset - 1);
+            return newline == std::string_view::npos ? text.size() : newline + 1;
+        };
+        pool.ParallelFor(chunks, 1, [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                size_t begin = lineStart(chunk * chunkSize);
+                size_t end = lineStart((chunk + 1) * chunkSize);
+                while (begin < end) {
+                    size_t newline = text.find('\n', begin);
+                    size_t lineEnd = newline == std::string_view::npos || newline >= end ? end : newline;
+                    std::string_view line = text.substr(begin, lineEnd - begin);
+                    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                    (Accepts(line) ? counts[chunk].accepted : counts[chunk].rejected)++;
+                    begin = lineEnd + 1;
+                }
+            }
+        });
+
+        LineCounts total;
+        for (const auto& count : counts) {
+            total.accepted += count.accepted;
+            total.rejected += count.rejected;
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_t EnumerateLimit = 64;
+    static constexpr size_t Lookback = 4096;
+
+    std::optional<BitParallelMatcher> nfa;
+    std::array<uint32_t, 256> byteColumn{};
+    uint32_t columns = 0;
+    uint32_t start = 0;
+    std::vector<uint32_t> table;
+    std::vector<uint8_t> accepting;
+
+    // The DFA walk from a row offset; stops early in the dead row.
+    uint32_t Run(uint32_t state, std::string_view text) const {
+        const uint32_t* next = table.data();
+        for (char c : text) {
+            state = next[state + byteColumn[static_cast<unsigned char>(c)]];
+            if (state == 0) break;
+        }
+        return state;
+    }
+
+    // Where text leads from each row, as row offsets indexed by row. Every
+    // 64 bytes, runs that have reached the same state are merged and runs in
+    // the dead row are dropped; once only one is left it finishes as a plain
+    // walk.
+    std::vector<uint32_t> RunAll(std::string_view text) const {
+        const uint32_t dead = UINT32_MAX;
+        const size_t rows = accepting.size();
+        std::vector<uint32_t> current(rows - 1), runOf(rows), merged(rows, dead), renumber(rows - 1);
+        runOf[0] = dead;
+        for (size_t row = 1; row < rows; ++row) {
+            current[row - 1] = static_cast<uint32_t>(row) * columns;
+            runOf[row] = static_cast<uint32_t>(row - 1);
+        }
+        size_t live = rows - 1;
+        const uint32_t* next = table.data();
+        for (size_t pos = 0; pos < text.size() && live > 0; pos += 64) {
+            if (live == 1) {
+                current[0] = Run(current[0], text.substr(pos));
+                break;
+            }
+            size_t end = std::min(text.size(), pos + 64);
+            for (size_t i = pos; i < end; ++i) {
+                uint32_t column = byteColumn[static_cast<unsigned char>(text[i])];
+                for (size_t run = 0; run < live; ++run) current[run] = next[current[run] + column];
+            }
+
+            size_t kept = 0;
+            for (size_t run = 0; run < live; ++run) {
+                uint32_t row = current[run] / columns;
+                if (row != 0 && merged[row] == dead) {
+                    merged[row] = static_cast<uint32_t>(kept);
+                    current[kept++] = current[run];
+                }
+                renumber[run] = row == 0 ? dead : merged[row];
+            }
+            for (size_t run = 0; run < kept; ++run) merged[current[run] / columns] = dead;
+            if (kept < live) {
+                for (auto& run : runOf)
+                    if (run != dead) run = renumber[run];
+                live = kept;
+            }
+        }
+
+        std::vector<uint32_t> result(rows, 0);
+        for (size_t row = 0; row < rows; ++row)
+            if (runOf[row] != dead) result[row] = current[runOf[row]];
+        return result;
+    }
+
+    // A whole file, read-only. Mapped where mmap exists, read otherwise.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+            std::ifstream in(path, std::ios::binary);
+            if (!in) throw std::runtime_error("cannot open " + path);
+            std::ostringstream buffer;
+            buffer << in.rdbuf();
+            contents = buffer.str();
+            data = contents;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("cannot open " + path);
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("cannot stat " + path);
+            }
+            size = static_cast<size_t>(info.st_size);
+            if (size > 0) {
+                mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("cannot map " + path);
+                }
+                ::madvise(mapping, size, MADV_SEQUENTIAL);
+                data = std::string_view(static_cast<const char*>(mapping), size);
+            }
+            ::close(fd);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+#ifndef _WIN32
+            if (size > 0) ::munmap(mapping, size);
+#endif
+        }
+
+        std::string_view Data() const { return data; }
+
+    private:
+        std::string_view data;
+#ifdef _WIN32
+        std::string contents;
+#else
+        void* mapping = nullptr;
+        size_t size = 0;
+#endif
+    };
+};
+
+#endif
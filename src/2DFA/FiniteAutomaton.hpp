@@ -5,157 +5,575 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
-#include <queue>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <fstream>
-#include "grammar.hpp"
-#include "hashSetCompar.hpp"
+#include <stdexcept>
+#include "Grammar.hpp"
+#include "SubsetTable.hpp"
 
+// States and symbols are numbered 0..n-1 internally. A deterministic
+// automaton keeps its transitions in a flat states x symbols table, a
+// nondeterministic one in CSR form (one run of targets per state/symbol
+// pair). The string-keyed sets and maps of the public API are views that are
+// built the first time one of them is asked for.
 class FiniteAutomaton {
 public:
     using State = std::string;
     using Symbol = std::string;
     using TransitionMap = std::unordered_map<State, std::unordered_map<Symbol, std::unordered_set<State>>>;
+    using StateId = uint32_t;
+    using SymbolId = uint32_t;
 
-    std::unordered_set<State> States;
-    std::unordered_set<Symbol> Alphabet;
-    TransitionMap Transitions;
-    State StartState;
-    std::unordered_set<State> FinalStates;
+    static constexpr uint32_t None = UINT32_MAX;
+
+    struct Edge {
+        StateId from;
+        SymbolId symbol;
+        StateId to;
+    };
+
+    // The targets of one state on one symbol.
+    struct Targets {
+        const StateId* first;
+        const StateId* last;
+        const StateId* begin() const { return first; }
+        const StateId* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
 
     FiniteAutomaton(
         const std::unordered_set<State>& states,
         const std::unordered_set<Symbol>& alphabet,
         const TransitionMap& transitions,
         const State& startState,
-        const std::unordered_set<State>& finalStates)
-        : States(states), Alphabet(alphabet), Transitions(transitions), StartState(startState), FinalStates(finalStates) {}
+        const std::unordered_set<State>& finalStates) {
+        std::unordered_map<State, StateId> stateIndex;
+        std::unordered_map<Symbol, SymbolId> symbolIndex;
+        auto stateId = [&](const State& state) {
+            auto [it, inserted] = stateIndex.emplace(state, static_cast<StateId>(stateNames.size()));
+            if (inserted) stateNames.push_back(state);
+            return it->second;
+        };
+        auto symbolId = [&](const Symbol& symbol) {
+            auto [it, inserted] = symbolIndex.emplace(symbol, static_cast<SymbolId>(symbolNames.size()));
+            if (inserted) symbolNames.push_back(symbol);
+            return it->second;
+        };
 
-    bool StringBelongsToLanguage(const std::string& inputString) {
-        std::unordered_set<State> currentStates = { StartState };
+        start = stateId(startState);
+        for (const auto& state : states) stateId(state);
+        for (const auto& symbol : alphabet) symbolId(symbol);
+
+        std::vector<Edge> edges;
+        for (const auto& [state, moves] : transitions) {
+            StateId from = stateId(state);
+            for (const auto& [symbol, targets] : moves) {
+                SymbolId a = symbolId(symbol);
+                for (const auto& target : targets) edges.push_back({from, a, stateId(target)});
+            }
+        }
+
+        finals.assign(stateNames.size(), 0);
+        for (const auto& state : finalStates) finals[stateId(state)] = 1;
+        Build(std::move(edges));
+    }
 
+    // Builds an automaton over states 0..stateCount-1. States are named
+    // "q<id>" unless names are given.
+    static FiniteAutomaton FromEdges(
+        std::vector<Symbol> symbols,
+        size_t stateCount,
+        std::vector<Edge> edges,
+        StateId start,
+        std::vector<uint8_t> finals,
+        std::vector<State> names = {}) {
+        FiniteAutomaton automaton;
+        automaton.symbolNames = std::move(symbols);
+        automaton.stateNames = names.empty() ? NumberedNames(stateCount) : std::move(names);
+        automaton.start = start;
+        automaton.finals = std::move(finals);
+        automaton.finals.resize(stateCount, 0);
+        automaton.Build(std::move(edges));
+        return automaton;
+    }
+
+    // The automaton of a right-linear grammar. Nonterminals become states;
+    // a production such as "abB" becomes a path over a and b into B, one
+    // with no nonterminal ends in an extra final state, and an empty one
+    // makes its nonterminal final. Any other production throws
+    // std::invalid_argument.
+    static FiniteAutomaton FromGrammar(const Grammar& grammar) {
+        std::vector<State> names(grammar.NonTerminals.begin(), grammar.NonTerminals.end());
+        std::sort(names.begin(), names.end());
+        auto startIt = std::find(names.begin(), names.end(), grammar.StartSymbol);
+        if (startIt == names.end()) throw std::invalid_argument("start symbol is not a nonterminal");
+        std::iter_swap(names.begin(), startIt);
+        std::unordered_map<State, StateId> stateOf;
+        for (StateId state = 0; state < names.size(); ++state) stateOf[names[state]] = state;
+        const StateId accept = static_cast<StateId>(names.size());
+        names.push_back("#final");
+
+        std::vector<Symbol> symbols(grammar.Terminals.begin(), grammar.Terminals.end());
+        std::sort(symbols.begin(), symbols.end());
+        std::unordered_map<Symbol, SymbolId> symbolOf;
+        for (SymbolId symbol = 0; symbol < symbols.size(); ++symbol) symbolOf[symbols[symbol]] = symbol;
+
+        std::vector<Edge> edges;
+        std::vector<uint8_t> finals(names.size(), 0);
+        finals[accept] = 1;
+        for (const auto& [left, rules] : grammar.Productions) {
+            auto from = stateOf.find(left);
+            if (from == stateOf.end()) throw std::invalid_argument("production for unknown nonterminal " + left);
+            for (const auto& rule : rules) {
+                std::vector<SymbolId> path;
+                StateId target = accept;
+                for (size_t i = 0; i < rule.size(); ++i) {
+                    std::string symbol(1, rule[i]);
+                    if (rule[i] == ' ') continue;
+                    if (auto terminal = symbolOf.find(symbol); terminal != symbolOf.end()) {
+                        path.push_back(terminal->second);
+                    } else if (auto nonTerminal = stateOf.find(symbol);
+                               nonTerminal != stateOf.end() && rule.find_first_not_of(' ', i + 1) == std::string::npos) {
+                        target = nonTerminal->second;
+                    } else {
+                        throw std::invalid_argument("production " + left + " -> " + rule + " is not right-linear");
+                    }
+                }
+                if (path.empty()) {
+                    if (target != accept) throw std::invalid_argument("unit production " + left + " -> " + rule);
+                    finals[from->second] = 1;
+                    continue;
+                }
+                StateId state = from->second;
+                for (size_t i = 0; i + 1 < path.size(); ++i) {
+                    auto middle = static_cast<StateId>(names.size());
+                    names.push_back("#" + std::to_string(middle));
+                    finals.push_back(0);
+                    edges.push_back({state, path[i], middle});
+                    state = middle;
+                }
+                edges.push_back({state, path.back(), target});
+            }
+        }
+        const size_t stateCount = names.size();
+        return FromEdges(std::move(symbols), stateCount, std::move(edges), 0, std::move(finals), std::move(names));
+    }
+
+    // Views in terms of names.
+    const std::unordered_set<State>& States() const { return Views().states; }
+    const std::unordered_set<Symbol>& Alphabet() const { return Views().alphabet; }
+    const TransitionMap& Transitions() const { return Views().transitions; }
+    const State& StartState() const { return stateNames[start]; }
+    const std::unordered_set<State>& FinalStates() const { return Views().finals; }
+
+    // The dense form.
+    size_t StateCount() const { return stateNames.size(); }
+    size_t SymbolCount() const { return symbolNames.size(); }
+    StateId Start() const { return start; }
+    bool IsFinal(StateId state) const { return finals[state] != 0; }
+    const State& StateName(StateId state) const { return stateNames[state]; }
+    const Symbol& SymbolName(SymbolId symbol) const { return symbolNames[symbol]; }
+
+    // The symbol spelled by one character, or None.
+    SymbolId SymbolOf(char c) const { return symbolOfChar[static_cast<unsigned char>(c)]; }
+
+    SymbolId FindSymbol(const Symbol& symbol) const {
+        auto it = std::find(symbolNames.begin(), symbolNames.end(), symbol);
+        return it == symbolNames.end() ? None : static_cast<SymbolId>(it - symbolNames.begin());
+    }
+
+    Targets Successors(StateId state, SymbolId symbol) const {
+        size_t cell = static_cast<size_t>(state) * symbolNames.size() + symbol;
+        if (deterministic) {
+            const StateId* target = table.data() + cell;
+            return {target, target + (*target != None)};
+        }
+        return {targets.data() + offsets[cell], targets.data() + offsets[cell + 1]};
+    }
+
+    // The only successor of a deterministic automaton, or None.
+    StateId Next(StateId state, SymbolId symbol) const {
+        return table[static_cast<size_t>(state) * symbolNames.size() + symbol];
+    }
+
+    bool StringBelongsToLanguage(const std::string& inputString) const {
+        if (deterministic) {
+            StateId state = start;
+            for (char c : inputString) {
+                SymbolId symbol = SymbolOf(c);
+                if (symbol == None) return false;
+                state = Next(state, symbol);
+                if (state == None) return false;
+            }
+            return IsFinal(state);
+        }
+
+        std::vector<StateId> currentStates = { start };
+        std::vector<StateId> nextStates;
+        std::vector<uint8_t> seen(StateCount(), 0);
         for (char c : inputString) {
-            std::unordered_set<State> nextStates;
-            std::string symbol(1, c);
-            for (const auto& state : currentStates) {
-                if (Transitions.count(state) && Transitions[state].count(symbol)) {
-                    nextStates.insert(Transitions[state][symbol].begin(), Transitions[state][symbol].end());
+            SymbolId symbol = SymbolOf(c);
+            if (symbol == None) return false;
+            nextStates.clear();
+            for (StateId state : currentStates) {
+                for (StateId target : Successors(state, symbol)) {
+                    if (!seen[target]) {
+                        seen[target] = 1;
+                        nextStates.push_back(target);
+                    }
                 }
             }
+            for (StateId state : nextStates) seen[state] = 0;
 
             if (nextStates.empty()) return false;
-            currentStates = nextStates;
+            std::swap(currentStates, nextStates);
         }
 
-        for (const auto& state : currentStates) {
-            if (FinalStates.count(state)) return true;
+        for (StateId state : currentStates) {
+            if (IsFinal(state)) return true;
         }
         return false;
     }
 
-    bool IsDeterministic() {
-        for (const auto& [state, transitions] : Transitions) {
-            for (const auto& [symbol, targets] : transitions) {
-                if (targets.size() > 1) return false; 
-            }
-        }
-        return true;
+    bool IsDeterministic() const {
+        return deterministic;
     }
 
-    FiniteAutomaton ConvertToDFA() {
+    // Subset construction over bitsets of NFA states. A DFA state is named
+    // after its subset, e.g. "{q0,q2}". The result is partial: a subset with
+    // no move on a symbol has no transition instead of going to an empty state.
+    // Throws std::length_error once the subsets, their transitions and their
+    // names would take more than maxBytes.
+    FiniteAutomaton ConvertToDFA(size_t maxBytes = SIZE_MAX) const {
         if (IsDeterministic()) return *this;
 
-        std::unordered_set<State> newStates;
-        TransitionMap newTransitions;
-        std::unordered_set<State> newFinalStates;
-        std::queue<std::unordered_set<State>> queue;
-        std::unordered_map<std::unordered_set<State>, State, HashSetComparer> stateMapping;
-
-        std::unordered_set<State> startSet = { StartState };
-        queue.push(startSet);
-        stateMapping[startSet] = JoinStates(startSet);
-        newStates.insert(stateMapping[startSet]);
-
-        if (ContainsFinalState(startSet)) newFinalStates.insert(stateMapping[startSet]);
-
-        while (!queue.empty()) {
-            auto currentSet = queue.front();
-            queue.pop();
-            State currentState = stateMapping[currentSet];
-
-            for (const auto& symbol : Alphabet) {
-                std::unordered_set<State> nextSet;
-                for (const auto& state : currentSet) {
-                    if (Transitions.count(state) && Transitions[state].count(symbol)) {
-                        nextSet.insert(Transitions[state][symbol].begin(), Transitions[state][symbol].end());
+        const size_t symbolCount = SymbolCount();
+        const size_t words = (StateCount() + 63) / 64;
+        SubsetTable subsets(words);
+        std::vector<uint64_t> currentSet(words, 0), nextSet(words);
+        size_t bytes = 0;
+        auto charge = [&](const uint64_t* subset) {
+            bytes += words * sizeof(uint64_t) + symbolCount * sizeof(StateId) + 2;
+            for (size_t w = 0; w < words; ++w) {
+                for (uint64_t bits = subset[w]; bits; bits &= bits - 1) {
+                    bytes += stateNames[w * 64 + CountTrailingZeros(bits)].size() + 1;
+                }
+            }
+            if (bytes > maxBytes) {
+                throw std::length_error("subset construction needs more than " + std::to_string(maxBytes >> 20) +
+                                        " MB");
+            }
+        };
+        currentSet[start / 64] |= uint64_t(1) << (start % 64);
+        subsets.Insert(currentSet.data());
+        charge(currentSet.data());
+
+        std::vector<StateId> newTransitions;
+        for (StateId current = 0; current < subsets.Size(); ++current) {
+            std::copy(subsets.Subset(current), subsets.Subset(current) + words, currentSet.begin());
+            for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                std::fill(nextSet.begin(), nextSet.end(), 0);
+                uint64_t any = 0;
+                for (size_t w = 0; w < words; ++w) {
+                    for (uint64_t bits = currentSet[w]; bits; bits &= bits - 1) {
+                        StateId state = static_cast<StateId>(w * 64 + CountTrailingZeros(bits));
+                        for (StateId target : Successors(state, symbol)) {
+                            nextSet[target / 64] |= uint64_t(1) << (target % 64);
+                            any = 1;
+                        }
                     }
                 }
+                if (!any) {
+                    newTransitions.push_back(None);
+                    continue;
+                }
+                auto [target, added] = subsets.Insert(nextSet.data());
+                if (added) charge(nextSet.data());
+                newTransitions.push_back(target);
+            }
+        }
+
+        FiniteAutomaton dfa;
+        dfa.symbolNames = symbolNames;
+        dfa.symbolOfChar = symbolOfChar;
+        dfa.table = std::move(newTransitions);
+        dfa.stateNames.reserve(subsets.Size());
+        dfa.finals.reserve(subsets.Size());
+        for (StateId id = 0; id < subsets.Size(); ++id) {
+            dfa.stateNames.push_back(SubsetName(subsets.Subset(id), words));
+            dfa.finals.push_back(ContainsFinalState(subsets.Subset(id), words));
+        }
+        return dfa;
+    }
+
+    // Hopcroft's partition refinement. Unreachable states are dropped and
+    // states that no input can tell apart are merged; each merged state keeps
+    // the name of the first of its states that breadth-first search meets.
+    // States are numbered in that breadth-first order, so equivalent DFAs
+    // over the same alphabet minimize to the same table. An NFA is first
+    // determinized within maxBytes, as in ConvertToDFA.
+    FiniteAutomaton Minimize(size_t maxBytes = SIZE_MAX) const {
+        if (!IsDeterministic()) return ConvertToDFA(maxBytes).Minimize();
+
+        const size_t symbolCount = SymbolCount();
+
+        // Reachable states, renumbered, plus one dead state for the missing moves.
+        std::vector<StateId> reachable = { start };
+        std::vector<StateId> index(StateCount(), None);
+        index[start] = 0;
+        for (size_t i = 0; i < reachable.size(); ++i) {
+            for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                StateId target = Next(reachable[i], symbol);
+                if (target != None && index[target] == None) {
+                    index[target] = static_cast<StateId>(reachable.size());
+                    reachable.push_back(target);
+                }
+            }
+        }
+        const StateId dead = static_cast<StateId>(reachable.size());
+        const size_t total = reachable.size() + 1;
+        std::vector<StateId> delta(total * symbolCount, dead);
+        for (StateId state = 0; state < dead; ++state) {
+            for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                StateId target = Next(reachable[state], symbol);
+                if (target != None) delta[state * symbolCount + symbol] = index[target];
+            }
+        }
+
+        // Predecessors of every (state, symbol) pair, in CSR form.
+        std::vector<uint32_t> inverseOffsets(total * symbolCount + 1, 0);
+        std::vector<StateId> inverse(total * symbolCount);
+        for (size_t cell = 0; cell < delta.size(); ++cell)
+            inverseOffsets[delta[cell] * symbolCount + cell % symbolCount + 1]++;
+        for (size_t i = 0; i + 1 < inverseOffsets.size(); ++i) inverseOffsets[i + 1] += inverseOffsets[i];
+        {
+            std::vector<uint32_t> fill(inverseOffsets.begin(), inverseOffsets.end() - 1);
+            for (size_t cell = 0; cell < delta.size(); ++cell)
+                inverse[fill[delta[cell] * symbolCount + cell % symbolCount]++] = static_cast<StateId>(cell / symbolCount);
+        }
 
-                if (!nextSet.empty() && !stateMapping.count(nextSet)) {
-                    stateMapping[nextSet] = JoinStates(nextSet);
-                    queue.push(nextSet);
-                    newStates.insert(stateMapping[nextSet]);
-                    if (ContainsFinalState(nextSet)) newFinalStates.insert(stateMapping[nextSet]);
+        // The partition: each block is a run of `elements`, with the states
+        // marked by the current splitter moved to the front of the run.
+        std::vector<StateId> elements(total), location(total), blockOf(total);
+        std::vector<uint32_t> blockBegin, blockEnd, marked;
+        auto addBlock = [&](uint32_t begin, uint32_t end) {
+            uint32_t block = static_cast<uint32_t>(blockBegin.size());
+            blockBegin.push_back(begin);
+            blockEnd.push_back(end);
+            marked.push_back(0);
+            for (uint32_t i = begin; i < end; ++i) blockOf[elements[i]] = block;
+            return block;
+        };
+        uint32_t finalCount = 0;
+        for (StateId state = 0; state < dead; ++state)
+            if (IsFinal(reachable[state])) elements[finalCount++] = state;
+        for (StateId state = 0, rest = finalCount; state < total; ++state)
+            if (state == dead || !IsFinal(reachable[state])) elements[rest++] = state;
+        for (uint32_t i = 0; i < total; ++i) location[elements[i]] = i;
+        if (finalCount > 0) addBlock(0, finalCount);
+        addBlock(finalCount, static_cast<uint32_t>(total));
+
+        auto blockSize = [&](uint32_t block) { return blockEnd[block] - blockBegin[block]; };
+        std::vector<std::pair<uint32_t, SymbolId>> worklist;
+        std::vector<uint8_t> inWorklist(total * symbolCount, 0);
+        auto push = [&](uint32_t block, SymbolId symbol) {
+            inWorklist[block * symbolCount + symbol] = 1;
+            worklist.emplace_back(block, symbol);
+        };
+        if (blockBegin.size() == 2) {
+            uint32_t smaller = blockSize(0) <= blockSize(1) ? 0 : 1;
+            for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) push(smaller, symbol);
+        }
+
+        std::vector<uint32_t> touched;
+        std::vector<StateId> splitterStates;
+        while (!worklist.empty()) {
+            auto [splitter, symbol] = worklist.back();
+            worklist.pop_back();
+            inWorklist[splitter * symbolCount + symbol] = 0;
+
+            // Marking reorders blocks, the splitter included, so walk a copy.
+            splitterStates.assign(elements.begin() + blockBegin[splitter], elements.begin() + blockEnd[splitter]);
+            for (StateId target : splitterStates) {
+                size_t cell = target * symbolCount + symbol;
+                for (uint32_t p = inverseOffsets[cell]; p < inverseOffsets[cell + 1]; ++p) {
+                    StateId state = inverse[p];
+                    uint32_t block = blockOf[state];
+                    if (marked[block] == 0) touched.push_back(block);
+                    uint32_t to = blockBegin[block] + marked[block]++;
+                    StateId other = elements[to];
+                    std::swap(elements[location[state]], elements[to]);
+                    location[other] = location[state];
+                    location[state] = to;
                 }
+            }
+
+            for (uint32_t block : touched) {
+                uint32_t split = blockBegin[block] + marked[block];
+                marked[block] = 0;
+                if (split == blockEnd[block]) continue;
 
-                newTransitions[currentState][symbol] = { stateMapping[nextSet] };
+                // The smaller half becomes the new block.
+                uint32_t created;
+                if (split - blockBegin[block] <= blockEnd[block] - split) {
+                    created = addBlock(blockBegin[block], split);
+                    blockBegin[block] = split;
+                } else {
+                    created = addBlock(split, blockEnd[block]);
+                    blockEnd[block] = split;
+                }
+                for (SymbolId c = 0; c < symbolCount; ++c) {
+                    if (inWorklist[block * symbolCount + c] || blockSize(created) <= blockSize(block)) push(created, c);
+                    else push(block, c);
+                }
             }
+            touched.clear();
         }
 
-        return FiniteAutomaton(newStates, Alphabet, newTransitions, stateMapping[startSet], newFinalStates);
+        // Number the blocks breadth-first from the start, leaving out the dead one.
+        const uint32_t deadBlock = blockOf[dead];
+        std::vector<StateId> number(blockBegin.size(), None);
+        std::vector<StateId> representative = { 0 };
+        number[blockOf[0]] = 0;
+        FiniteAutomaton minimal;
+        minimal.symbolNames = symbolNames;
+        minimal.symbolOfChar = symbolOfChar;
+        for (size_t i = 0; i < representative.size(); ++i) {
+            StateId state = representative[i];
+            minimal.stateNames.push_back(stateNames[reachable[state]]);
+            minimal.finals.push_back(IsFinal(reachable[state]));
+            for (SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                StateId target = delta[state * symbolCount + symbol];
+                uint32_t block = blockOf[target];
+                if (block == deadBlock) {
+                    minimal.table.push_back(None);
+                    continue;
+                }
+                if (number[block] == None) {
+                    number[block] = static_cast<StateId>(representative.size());
+                    representative.push_back(target);
+                }
+                minimal.table.push_back(number[block]);
+            }
+        }
+        return minimal;
     }
 
-    Grammar ToGrammar() {
-        std::unordered_map<State, std::string> stateToNonTerminal;
+    // Whether both automata accept the same strings, by the Hopcroft-Karp
+    // union-find check on their DFAs. Symbols are matched up by name.
+    bool Equivalent(const FiniteAutomaton& other) const {
+        if (!IsDeterministic() || !other.IsDeterministic())
+            return ConvertToDFA().Equivalent(other.ConvertToDFA());
+
+        std::vector<SymbolId> otherSymbol(SymbolCount());
+        std::vector<SymbolId> extraSymbols;
+        for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol) otherSymbol[symbol] = other.FindSymbol(symbolNames[symbol]);
+        for (SymbolId symbol = 0; symbol < other.SymbolCount(); ++symbol)
+            if (FindSymbol(other.symbolNames[symbol]) == None) extraSymbols.push_back(symbol);
+
+        // Nodes 0..n-1 are this automaton's states and n its dead state;
+        // the other automaton's follow from n + 1 on.
+        const StateId n = static_cast<StateId>(StateCount());
+        const StateId offset = n + 1;
+        const StateId otherDead = offset + static_cast<StateId>(other.StateCount());
+        std::vector<StateId> parent(otherDead + 1);
+        for (StateId node = 0; node <= otherDead; ++node) parent[node] = node;
+        auto find = [&](StateId node) {
+            while (parent[node] != node) node = parent[node] = parent[parent[node]];
+            return node;
+        };
+        auto isFinal = [&](StateId node) {
+            if (node < n) return IsFinal(node);
+            if (node > n && node < otherDead) return other.IsFinal(node - offset);
+            return false;
+        };
+
+        std::vector<std::pair<StateId, StateId>> pending;
+        auto merge = [&](StateId x, StateId y) {
+            StateId rx = find(x), ry = find(y);
+            if (rx == ry) return true;
+            if (isFinal(x) != isFinal(y)) return false;
+            parent[rx] = ry;
+            pending.emplace_back(x, y);
+            return true;
+        };
+        auto step = [&](StateId node, SymbolId symbol) {
+            if (node == n || symbol == None) return n;
+            StateId target = Next(node, symbol);
+            return target == None ? n : target;
+        };
+        auto otherStep = [&](StateId node, SymbolId symbol) {
+            if (node == otherDead || symbol == None) return otherDead;
+            StateId target = other.Next(node - offset, symbol);
+            return target == None ? otherDead : target + offset;
+        };
+
+        if (!merge(start, other.start + offset)) return false;
+        while (!pending.empty()) {
+            auto [x, y] = pending.back();
+            pending.pop_back();
+            for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol)
+                if (!merge(step(x, symbol), otherStep(y, otherSymbol[symbol]))) return false;
+            for (SymbolId symbol : extraSymbols)
+                if (!merge(step(x, None), otherStep(y, symbol))) return false;
+        }
+        return true;
+    }
+
+    Grammar ToGrammar() const {
+        std::vector<std::string> stateToNonTerminal(StateCount());
         std::unordered_set<std::string> nonTerminals;
-        std::unordered_set<std::string> terminals(Alphabet);
+        std::unordered_set<std::string> terminals(Alphabet());
         std::unordered_map<std::string, std::vector<std::string>> productions;
 
         // Create a mapping of states to non-terminals (A, B, C, ...)
-        char nonTerminalLetter = 'A';  
-        for (const auto& state : States) {
+        char nonTerminalLetter = 'A';
+        for (StateId state = 0; state < StateCount(); ++state) {
             std::string nonTerminal(1, nonTerminalLetter++);
             stateToNonTerminal[state] = nonTerminal;
             nonTerminals.insert(nonTerminal);
 
-            std::cout << state << " -> " << nonTerminal << std::endl;
+            std::cout << stateNames[state] << " -> " << nonTerminal << std::endl;
         }
 
-        for (const auto& [state, transitions] : Transitions) {
-            std::string nonTerminal = stateToNonTerminal[state];
-            for (const auto& [symbol, targets] : transitions) {
-                for (const auto& target : targets) {
-                    std::string targetNonTerminal = stateToNonTerminal[target];
-                    productions[nonTerminal].push_back(symbol + targetNonTerminal);
-                    if (FinalStates.count(target)) {
-                        productions[nonTerminal].push_back(symbol); 
+        for (StateId state = 0; state < StateCount(); ++state) {
+            const std::string& nonTerminal = stateToNonTerminal[state];
+            for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol) {
+                for (StateId target : Successors(state, symbol)) {
+                    productions[nonTerminal].push_back(symbolNames[symbol] + stateToNonTerminal[target]);
+                    if (IsFinal(target)) {
+                        productions[nonTerminal].push_back(symbolNames[symbol]);
                     }
                 }
             }
         }
 
-        return Grammar(nonTerminals, terminals, productions, stateToNonTerminal[StartState]);
+        return Grammar(nonTerminals, terminals, productions, stateToNonTerminal[start]);
     }
 
-    bool VerifyGeneratedString(const std::string& str, const Grammar& grammar) {
+    bool VerifyGeneratedString(const std::string& str, const Grammar& grammar) const {
         return StringBelongsToLanguage(str);
     }
 
 
-void ToDot(const std::string& filename = "DFA.dot") {
+void ToDot(const std::string& filename = "DFA.dot") const {
     std::ostringstream sb;
     sb << "digraph DFA {\n";
     sb << "  rankdir=LR;\n  node [shape=circle];\n";
-    for (const auto& finalState : FinalStates) {
-        sb << "  \"" << finalState << "\" [shape=doublecircle];\n";
+    for (StateId state = 0; state < StateCount(); ++state) {
+        if (IsFinal(state)) sb << "  \"" << stateNames[state] << "\" [shape=doublecircle];\n";
     }
-    sb << "  \"\" -> \"" << StartState << "\" [label=\"start\"];\n";
-    for (const auto& [state, transitions] : Transitions) {
-        for (const auto& [symbol, targets] : transitions) {
-            for (const auto& target : targets) {
-                sb << "  \"" << state << "\" -> \"" << target << "\" [label=\"" << symbol << "\"];\n";
+    sb << "  \"\" -> \"" << stateNames[start] << "\" [label=\"start\"];\n";
+    for (StateId state = 0; state < StateCount(); ++state) {
+        for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol) {
+            for (StateId target : Successors(state, symbol)) {
+                sb << "  \"" << stateNames[state] << "\" -> \"" << stateNames[target] << "\" [label=\"" << symbolNames[symbol] << "\"];\n";
             }
         }
     }
@@ -171,26 +589,26 @@ void ToDot(const std::string& filename = "DFA.dot") {
 }
 
 
-    void PrintDFA() {
+    void PrintDFA() const {
         std::cout << "\nDFA Representation:\n";
         std::cout << "States: ";
-        for (const auto& state : States) {
+        for (const auto& state : stateNames) {
             std::cout << state << " ";
         }
         std::cout << "\nAlphabet: ";
-        for (const auto& symbol : Alphabet) {
+        for (const auto& symbol : symbolNames) {
             std::cout << symbol << " ";
         }
-        std::cout << "\nStart State: " << StartState << "\n";
+        std::cout << "\nStart State: " << stateNames[start] << "\n";
         std::cout << "Final States: ";
-        for (const auto& state : FinalStates) {
-            std::cout << state << " ";
+        for (StateId state = 0; state < StateCount(); ++state) {
+            if (IsFinal(state)) std::cout << stateNames[state] << " ";
         }
         std::cout << "\nTransitions:\n";
-        for (const auto& [state, transitions] : Transitions) {
-            for (const auto& [symbol, targets] : transitions) {
-                for (const auto& target : targets) {
-                    std::cout << state << " --(" << symbol << ")--> " << target << "\n";
+        for (StateId state = 0; state < StateCount(); ++state) {
+            for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol) {
+                for (StateId target : Successors(state, symbol)) {
+                    std::cout << stateNames[state] << " --(" << symbolNames[symbol] << ")--> " << stateNames[target] << "\n";
                 }
             }
         }
@@ -198,17 +616,107 @@ void ToDot(const std::string& filename = "DFA.dot") {
     }
 
 private:
-    static std::string JoinStates(const std::unordered_set<State>& states) {
-        std::string result;
-        for (const auto& state : states) {
-            result += state;
+    struct NameViews {
+        std::unordered_set<State> states;
+        std::unordered_set<Symbol> alphabet;
+        TransitionMap transitions;
+        std::unordered_set<State> finals;
+    };
+
+    std::vector<State> stateNames;
+    std::vector<Symbol> symbolNames;
+    std::array<SymbolId, 256> symbolOfChar;
+    StateId start = 0;
+    std::vector<uint8_t> finals;
+    bool deterministic = true;
+    std::vector<StateId> table;     // deterministic: [state * symbols + symbol], None if there is no move
+    std::vector<uint32_t> offsets;  // otherwise CSR: the targets of cell i are targets[offsets[i]..offsets[i+1])
+    std::vector<StateId> targets;
+    // Shared between copies; not safe to build from two threads at once.
+    mutable std::shared_ptr<const NameViews> views;
+
+    FiniteAutomaton() = default;
+
+    static std::vector<State> NumberedNames(size_t count) {
+        std::vector<State> names(count);
+        for (size_t i = 0; i < count; ++i) names[i] = "q" + std::to_string(i);
+        return names;
+    }
+
+    // Fills in the one-character symbol table and the transition storage.
+    void Build(std::vector<Edge> edges) {
+        symbolOfChar.fill(None);
+        for (SymbolId symbol = 0; symbol < symbolNames.size(); ++symbol) {
+            const Symbol& name = symbolNames[symbol];
+            if (name.size() == 1) symbolOfChar[static_cast<unsigned char>(name[0])] = symbol;
+        }
+
+        std::sort(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) {
+            if (x.from != y.from) return x.from < y.from;
+            if (x.symbol != y.symbol) return x.symbol < y.symbol;
+            return x.to < y.to;
+        });
+        edges.erase(std::unique(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) {
+            return x.from == y.from && x.symbol == y.symbol && x.to == y.to;
+        }), edges.end());
+
+        const size_t symbolCount = symbolNames.size();
+        const size_t cells = stateNames.size() * symbolCount;
+        deterministic = true;
+        for (size_t i = 1; i < edges.size(); ++i) {
+            if (edges[i].from == edges[i - 1].from && edges[i].symbol == edges[i - 1].symbol) {
+                deterministic = false;
+                break;
+            }
         }
-        return result;
+
+        if (deterministic) {
+            table.assign(cells, None);
+            for (const Edge& edge : edges) table[edge.from * symbolCount + edge.symbol] = edge.to;
+            return;
+        }
+        offsets.assign(cells + 1, 0);
+        for (const Edge& edge : edges) offsets[edge.from * symbolCount + edge.symbol + 1]++;
+        for (size_t i = 0; i < cells; ++i) offsets[i + 1] += offsets[i];
+        targets.reserve(edges.size());
+        for (const Edge& edge : edges) targets.push_back(edge.to);
+    }
+
+    const NameViews& Views() const {
+        if (!views) {
+            auto built = std::make_shared<NameViews>();
+            built->states.insert(stateNames.begin(), stateNames.end());
+            built->alphabet.insert(symbolNames.begin(), symbolNames.end());
+            for (StateId state = 0; state < StateCount(); ++state) {
+                if (IsFinal(state)) built->finals.insert(stateNames[state]);
+                for (SymbolId symbol = 0; symbol < SymbolCount(); ++symbol) {
+                    Targets moves = Successors(state, symbol);
+                    if (moves.empty()) continue;
+                    auto& names = built->transitions[stateNames[state]][symbolNames[symbol]];
+                    for (StateId target : moves) names.insert(stateNames[target]);
+                }
+            }
+            views = std::move(built);
+        }
+        return *views;
+    }
+
+    std::string SubsetName(const uint64_t* subset, size_t words) const {
+        std::string result = "{";
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = subset[w]; bits; bits &= bits - 1) {
+                if (result.size() > 1) result += ',';
+                result += stateNames[w * 64 + CountTrailingZeros(bits)];
+            }
+        }
+        return result + "}";
     }
 
-    bool ContainsFinalState(const std::unordered_set<State>& states) {
-        for (const auto& state : states) {
-            if (FinalStates.count(state)) return true;
+    bool ContainsFinalState(const uint64_t* subset, size_t words) const {
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = subset[w]; bits; bits &= bits - 1) {
+                if (IsFinal(static_cast<StateId>(w * 64 + CountTrailingZeros(bits)))) return true;
+            }
         }
         return false;
     }
@@ -8,6 +8,7 @@
 #include <string>
 #include <random>
 #include <algorithm>
+#include <cstdint>
 
 class Grammar {
 public:
@@ -29,41 +30,112 @@ public:
 
     std::vector<std::string> GenerateStrings(int count = 5) {
         std::vector<std::string> generatedStrings;
-        for (int i = 0; i < count; i++) {
-            std::string generatedWord = GenerateString(StartSymbol);
+        GenerateWords(count, [&](const std::string& generatedWord) {
             std::cout << generatedWord << std::endl;
             generatedStrings.push_back(generatedWord);
-        }
+        });
         return generatedStrings;
     }
 
-private:
-    std::string GenerateString(const Symbol& symbol) {
-        if (Terminals.find(symbol) != Terminals.end()) {
-            return symbol;
+    // Calls sink(const std::string&) with count words derived from the start
+    // symbol. The word buffer is reused between calls.
+    template <typename Sink>
+    void GenerateWords(size_t count, Sink&& sink) const {
+        Derivation derivation(*this);
+        std::string word;
+        for (size_t i = 0; i < count; ++i) {
+            word.clear();
+            derivation.Generate(rng, word);
+            sink(word);
         }
+    }
 
-        if (Productions.find(symbol) != Productions.end()) {
-            auto& rules = Productions[symbol];
-            std::uniform_int_distribution<int> distrib(0, rules.size() - 1);
-            std::string rule = rules[distrib(rng)];
+private:
+    // The productions with every symbol interned: code c < 256 is the
+    // terminal byte c and code 256 + i is nonterminal i. A word is derived
+    // leftmost-first with an explicit stack of codes, so its length is not
+    // limited by recursion depth and each symbol costs a push and a pop.
+    class Derivation {
+    public:
+        explicit Derivation(const Grammar& grammar) {
+            if (grammar.Terminals.count(grammar.StartSymbol) || !grammar.Productions.count(grammar.StartSymbol)) {
+                startWord = grammar.StartSymbol;
+                return;
+            }
+            std::unordered_map<Symbol, uint32_t> ids;
+            auto intern = [&](const Symbol& name) {
+                auto [it, added] = ids.emplace(name, static_cast<uint32_t>(names.size()));
+                if (added) names.push_back(name);
+                return it->second;
+            };
+            start = intern(grammar.StartSymbol);
+
+            // Rules are read a character at a time, as symbols of one
+            // character; anything that is neither kind is skipped.
+            std::vector<std::vector<std::vector<uint32_t>>> rules;
+            for (size_t id = 0; id < names.size(); ++id) {
+                rules.emplace_back();
+                auto found = grammar.Productions.find(names[id]);
+                if (found == grammar.Productions.end()) continue;
+                for (const auto& rule : found->second) {
+                    std::vector<uint32_t> codes;
+                    for (char c : rule) {
+                        std::string symbol(1, c);
+                        if (grammar.Terminals.count(symbol)) codes.push_back(static_cast<unsigned char>(c));
+                        else if (grammar.NonTerminals.count(symbol)) codes.push_back(256 + intern(symbol));
+                    }
+                    rules[id].push_back(std::move(codes));
+                }
+            }
 
-            std::string result;
-            for (char c : rule) {
-                std::string symbolStr(1, c); 
+            for (const auto& alternatives : rules) {
+                firstRule.push_back(static_cast<uint32_t>(ruleOffsets.size()));
+                for (const auto& codes : alternatives) {
+                    ruleOffsets.push_back(static_cast<uint32_t>(pool.size()));
+                    pool.insert(pool.end(), codes.begin(), codes.end());
+                }
+            }
+            firstRule.push_back(static_cast<uint32_t>(ruleOffsets.size()));
+            ruleOffsets.push_back(static_cast<uint32_t>(pool.size()));
+        }
 
-                if (Terminals.find(symbolStr) != Terminals.end()) {
-                    result += symbolStr;
+        // Appends one word to out.
+        void Generate(std::mt19937& random, std::string& out) {
+            if (firstRule.empty()) {
+                out += startWord;
+                return;
+            }
+            stack.assign(1, 256 + start);
+            while (!stack.empty()) {
+                uint32_t code = stack.back();
+                stack.pop_back();
+                if (code < 256) {
+                    out += static_cast<char>(code);
+                    continue;
                 }
-                else if (NonTerminals.find(symbolStr) != NonTerminals.end()) {
-                    result += GenerateString(symbolStr);
+                uint32_t id = code - 256;
+                uint32_t rules = firstRule[id + 1] - firstRule[id];
+                if (rules == 0) {
+                    // A nonterminal without productions stands for itself.
+                    out += names[id];
+                    continue;
                 }
+                std::uniform_int_distribution<uint32_t> pick(0, rules - 1);
+                uint32_t rule = firstRule[id] + pick(random);
+                // Pushed right to left so the leftmost symbol is on top.
+                for (uint32_t i = ruleOffsets[rule + 1]; i > ruleOffsets[rule]; --i) stack.push_back(pool[i - 1]);
             }
-            return result;
         }
 
-        return symbol;
-    }
+    private:
+        std::vector<Symbol> names;
+        uint32_t start = 0;
+        std::vector<uint32_t> firstRule;    // rules of nonterminal i: firstRule[i] .. firstRule[i + 1]
+        std::vector<uint32_t> ruleOffsets;  // codes of rule r: pool[ruleOffsets[r]] .. pool[ruleOffsets[r + 1]]
+        std::vector<uint32_t> pool;
+        std::vector<uint32_t> stack;
+        std::string startWord;
+    };
 
 public:
     std::string ClassifyGrammar() {
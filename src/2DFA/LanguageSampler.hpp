@@ -0,0 +1,139 @@
+#ifndef LANGUAGE_SAMPLER_H
+#define LANGUAGE_SAMPLER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomaton.hpp"
+
+// Counts how many words of each length an automaton accepts, up to a
+// maximum length, and uses the counts to draw words uniformly among all
+// words of one length or to list every word in lexicographic order. It works
+// on the DFA, where every word has exactly one path, so no word is counted
+// or listed twice.
+//
+// Counts are doubles: exact up to 2^53 and approximate beyond, which keeps
+// sampling uniform up to rounding. An NFA is determinized within maxBytes,
+// and the constructor throws std::length_error when its DFA does not fit.
+class LanguageSampler {
+public:
+    LanguageSampler(const FiniteAutomaton& automaton, size_t maxLength, size_t maxBytes = SIZE_MAX)
+        : dfa(automaton.Minimize(maxBytes)),
+          maxLength(maxLength), states(dfa.StateCount()) {
+        for (FiniteAutomaton::SymbolId symbol = 0; symbol < dfa.SymbolCount(); ++symbol) order.push_back(symbol);
+        std::sort(order.begin(), order.end(), [&](auto a, auto b) { return dfa.SymbolName(a) < dfa.SymbolName(b); });
+
+        // counts[l * states + s]: words of length l accepted from state s.
+        counts.assign((maxLength + 1) * states, 0.0);
+        within.assign((maxLength + 1) * states, 0.0);
+        for (FiniteAutomaton::StateId state = 0; state < states; ++state) {
+            counts[state] = within[state] = dfa.IsFinal(state) ? 1.0 : 0.0;
+        }
+        for (size_t length = 1; length <= maxLength; ++length) {
+            for (FiniteAutomaton::StateId state = 0; state < states; ++state) {
+                double total = 0;
+                for (FiniteAutomaton::SymbolId symbol = 0; symbol < dfa.SymbolCount(); ++symbol) {
+                    FiniteAutomaton::StateId target = dfa.Next(state, symbol);
+                    if (target != FiniteAutomaton::None) total += counts[(length - 1) * states + target];
+                }
+                counts[length * states + state] = total;
+                within[length * states + state] = within[(length - 1) * states + state] + total;
+            }
+        }
+    }
+
+    size_t MaxLength() const { return maxLength; }
+
+    // The number of accepted words of exactly this length.
+    double Count(size_t length) const {
+        return length <= maxLength && states > 0 ? counts[length * states + dfa.Start()] : 0.0;
+    }
+
+    // A word drawn uniformly among those of this length, if there are any.
+    template <typename Rng>
+    std::optional<std::string> Sample(size_t length, Rng& rng) const {
+        std::string word;
+        if (!Sample(length, rng, word)) return std::nullopt;
+        return word;
+    }
+
+    // The same, into a reused buffer; false if there is no such word.
+    template <typename Rng>
+    bool Sample(size_t length, Rng& rng, std::string& word) const {
+        word.clear();
+        if (Count(length) == 0) return false;
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        FiniteAutomaton::StateId state = dfa.Start();
+        for (size_t left = length; left > 0; --left) {
+            // Picks the symbol in proportion to the words that continue it.
+            double pick = unit(rng) * counts[left * states + state];
+            FiniteAutomaton::StateId chosen = FiniteAutomaton::None;
+            FiniteAutomaton::SymbolId chosenSymbol = 0;
+            for (FiniteAutomaton::SymbolId symbol : order) {
+                FiniteAutomaton::StateId target = dfa.Next(state, symbol);
+                if (target == FiniteAutomaton::None) continue;
+                double ways = counts[(left - 1) * states + target];
+                if (ways == 0) continue;
+                chosen = target;
+                chosenSymbol = symbol;
+                if (pick < ways) break;
+                pick -= ways;
+            }
+            word += dfa.SymbolName(chosenSymbol);
+            state = chosen;
+        }
+        return true;
+    }
+
+    // Calls sink(std::string_view) with every accepted word of at most
+    // length symbols (capped at MaxLength), in lexicographic order of the
+    // symbol names.
+    template <typename Sink>
+    void Enumerate(size_t length, Sink&& sink) const {
+        length = std::min(length, maxLength);
+        if (states == 0 || within[length * states + dfa.Start()] == 0) return;
+
+        // Depth-first, trying symbols in order; a word comes before the
+        // words it is a prefix of. Only states that still reach a final
+        // state within the remaining length are entered.
+        struct Frame {
+            FiniteAutomaton::StateId state;
+            size_t nextSymbol;
+            size_t wordSize;
+        };
+        std::string word;
+        std::vector<Frame> stack = {{dfa.Start(), 0, 0}};
+        if (dfa.IsFinal(dfa.Start())) sink(std::string_view(word));
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            size_t depth = stack.size() - 1;
+            if (depth == length || frame.nextSymbol == order.size()) {
+                stack.pop_back();
+                continue;
+            }
+            FiniteAutomaton::SymbolId symbol = order[frame.nextSymbol++];
+            FiniteAutomaton::StateId target = dfa.Next(frame.state, symbol);
+            if (target == FiniteAutomaton::None || within[(length - depth - 1) * states + target] == 0) continue;
+
+            word.resize(frame.wordSize);
+            word += dfa.SymbolName(symbol);
+            if (dfa.IsFinal(target)) sink(std::string_view(word));
+            stack.push_back({target, 0, word.size()});
+        }
+    }
+
+private:
+    FiniteAutomaton dfa;
+    size_t maxLength;
+    size_t states;
+    std::vector<FiniteAutomaton::SymbolId> order;
+    std::vector<double> counts;
+    // within[l * states + s]: words of length at most l accepted from s.
+    std::vector<double> within;
+};
+
+#endif
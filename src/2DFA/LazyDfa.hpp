@@ -0,0 +1,178 @@
+#ifndef LAZY_DFA_H
+#define LAZY_DFA_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomaton.hpp"
+#include "SubsetTable.hpp"
+
+// Matches with an NFA by determinizing it on the fly. A DFA state (a set of
+// NFA states) and each of its transitions are only built when some input
+// reaches them, and kept in a cache of bounded size. When the cache is full
+// it is flushed and rebuilt from the current state. If flushes come so close
+// together that the cache is not paying for itself, the rest of that input,
+// and of the inputs after it up to as many symbols as a cache fill should
+// last, is matched by stepping the NFA state set directly. Both that and
+// building a DFA state OR together precomputed successor masks, as in
+// BitParallelMatcher.
+//
+// The cache changes on every call, so one LazyDfa must not be used from two
+// threads at once.
+class LazyDfa {
+public:
+    struct Stats {
+        size_t statesBuilt = 0;
+        size_t flushes = 0;
+        size_t fallbacks = 0;
+    };
+
+    explicit LazyDfa(const FiniteAutomaton& automaton, size_t memoryBudget = size_t(1) << 20)
+        : nfa(automaton),
+          words((automaton.StateCount() + 63) / 64),
+          columns(automaton.SymbolCount()),
+          cache(words),
+          startSet(words, 0), scratch(words), stepped(words), finalMask(words, 0) {
+        startSet[nfa.Start() / 64] |= uint64_t(1) << (nfa.Start() % 64);
+        successors.assign(columns * nfa.StateCount() * words, 0);
+        for (FiniteAutomaton::StateId state = 0; state < nfa.StateCount(); ++state) {
+            if (nfa.IsFinal(state)) finalMask[state / 64] |= uint64_t(1) << (state % 64);
+            for (FiniteAutomaton::SymbolId symbol = 0; symbol < columns; ++symbol) {
+                uint64_t* row = Row(symbol, state);
+                for (FiniteAutomaton::StateId target : nfa.Successors(state, symbol))
+                    row[target / 64] |= uint64_t(1) << (target % 64);
+            }
+        }
+
+        // Subset bits, cached hash, table slots and one row of transitions;
+        // the successor masks are fixed and outside the budget.
+        size_t perState = words * 8 + 8 + 8 + columns * 4 + 1;
+        capacity = std::max<size_t>(16, memoryBudget / perState);
+    }
+
+    bool Accepts(std::string_view input) {
+        if (nfaSymbolsLeft > 0) {
+            nfaSymbolsLeft -= std::min(nfaSymbolsLeft, input.size());
+            return FinishWithNfa(startSet.data(), input);
+        }
+        if (start == Unknown) start = Add(startSet.data());
+        uint32_t state = start;
+        for (size_t i = 0; i < input.size(); ++i) {
+            FiniteAutomaton::SymbolId symbol = nfa.SymbolOf(input[i]);
+            if (symbol == FiniteAutomaton::None) return false;
+
+            uint32_t target = next[static_cast<size_t>(state) * columns + symbol];
+            if (target == Unknown) {
+                size_t flushesBefore = stats.flushes;
+                target = Build(state, symbol);
+                if (stats.flushes != flushesBefore && bytesSinceFlush < capacity * MinBytesPerState) {
+                    stats.fallbacks++;
+                    bytesSinceFlush = 0;
+                    nfaSymbolsLeft = capacity * MinBytesPerState;
+                    return target != Dead && FinishWithNfa(cache.Subset(target), input.substr(i + 1));
+                }
+                if (stats.flushes != flushesBefore) bytesSinceFlush = 0;
+            }
+            if (target == Dead) return false;
+            state = target;
+            bytesSinceFlush++;
+        }
+        return accepting[state] != 0;
+    }
+
+    const Stats& GetStats() const { return stats; }
+    size_t Capacity() const { return capacity; }
+
+private:
+    static constexpr uint32_t Unknown = UINT32_MAX;
+    static constexpr uint32_t Dead = UINT32_MAX - 1;
+    // A flush this many bytes per cached state after the previous one means
+    // the cache is thrashing.
+    static constexpr size_t MinBytesPerState = 10;
+
+    FiniteAutomaton nfa;
+    size_t words;
+    size_t columns;
+    size_t capacity;
+    SubsetTable cache;
+    std::vector<uint32_t> next;     // [state * columns + symbol]: a state, Dead or Unknown
+    std::vector<uint8_t> accepting;
+    uint32_t start = Unknown;
+    size_t bytesSinceFlush = 0;
+    size_t nfaSymbolsLeft = 0;
+    Stats stats;
+    std::vector<uint64_t> startSet, scratch, stepped, finalMask;
+    std::vector<uint64_t> successors; // [symbol][state][word]
+
+    uint64_t* Row(FiniteAutomaton::SymbolId symbol, FiniteAutomaton::StateId state) {
+        return successors.data() + (static_cast<size_t>(symbol) * nfa.StateCount() + state) * words;
+    }
+
+    // Sets to = the successors of from on symbol; false if there are none.
+    bool Step(const uint64_t* from, FiniteAutomaton::SymbolId symbol, uint64_t* to) const {
+        std::fill(to, to + words, 0);
+        const uint64_t* table = successors.data() + static_cast<size_t>(symbol) * nfa.StateCount() * words;
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = from[w]; bits; bits &= bits - 1) {
+                const uint64_t* row = table + (w * 64 + CountTrailingZeros(bits)) * words;
+                for (size_t k = 0; k < words; ++k) to[k] |= row[k];
+            }
+        }
+        uint64_t any = 0;
+        for (size_t k = 0; k < words; ++k) any |= to[k];
+        return any != 0;
+    }
+
+    uint32_t Add(const uint64_t* subset) {
+        auto [id, added] = cache.Insert(subset);
+        if (added) {
+            stats.statesBuilt++;
+            next.resize(next.size() + columns, Unknown);
+            bool final = false;
+            for (size_t w = 0; w < words; ++w) final = final || (subset[w] & finalMask[w]);
+            accepting.push_back(final);
+        }
+        return id;
+    }
+
+    void Flush() {
+        stats.flushes++;
+        cache.Clear();
+        next.clear();
+        accepting.clear();
+        start = Unknown;
+    }
+
+    uint32_t Build(uint32_t state, FiniteAutomaton::SymbolId symbol) {
+        std::copy(cache.Subset(state), cache.Subset(state) + words, scratch.begin());
+        if (!Step(scratch.data(), symbol, stepped.data())) {
+            next[static_cast<size_t>(state) * columns + symbol] = Dead;
+            return Dead;
+        }
+        if (cache.Size() >= capacity) {
+            // The state we came from is gone with the rest of the cache, so
+            // this transition is not recorded.
+            Flush();
+            return Add(stepped.data());
+        }
+        uint32_t target = Add(stepped.data());
+        next[static_cast<size_t>(state) * columns + symbol] = target;
+        return target;
+    }
+
+    bool FinishWithNfa(const uint64_t* from, std::string_view rest) {
+        std::copy(from, from + words, scratch.begin());
+        for (char c : rest) {
+            FiniteAutomaton::SymbolId symbol = nfa.SymbolOf(c);
+            if (symbol == FiniteAutomaton::None || !Step(scratch.data(), symbol, stepped.data())) return false;
+            scratch.swap(stepped);
+        }
+        for (size_t w = 0; w < words; ++w)
+            if (scratch[w] & finalMask[w]) return true;
+        return false;
+    }
+};
+
+#endif
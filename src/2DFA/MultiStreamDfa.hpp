@@ -0,0 +1,281 @@
+#ifndef MULTI_STREAM_DFA_H
+#define MULTI_STREAM_DFA_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <string_view>
+#include <vector>
+#include "FiniteAutomaton.hpp"
+#include "CompiledAutomaton.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MULTI_STREAM_X86 1
+#include <immintrin.h>
+#define MULTI_STREAM_AVX2 __attribute__((target("avx2")))
+#else
+#define MULTI_STREAM_X86 0
+#endif
+
+// Runs a small DFA over many strings at once. Strings are grouped by length
+// and taken 32 at a time; for as long as all 32 have input left, blocks of
+// 16 bytes from each are transposed so that one vector holds the next byte of
+// every string, and all 32 states advance together. The rest of each string
+// is finished one at a time.
+//
+// Two AVX2 kernels exist, picked at run time:
+//   Shuffle - up to 15 states and 8 one-character symbols: each symbol's
+//             transitions fit in one PSHUFB table of 16 rows.
+//   Gather  - up to 4095 states: VPGATHERDD from a states x 256 byte table.
+// Without AVX2, or for larger automata, every string takes the scalar walk.
+class MultiStreamDfa {
+public:
+    enum class Kernel { Scalar, Shuffle, Gather };
+
+    static constexpr size_t Lanes = 32;
+
+    // Nondeterministic automata are determinized and minimized first.
+    explicit MultiStreamDfa(const FiniteAutomaton& automaton) {
+        const FiniteAutomaton dfa = automaton.IsDeterministic() ? automaton : automaton.Minimize();
+        const size_t symbolCount = dfa.SymbolCount();
+        rows = static_cast<uint32_t>(dfa.StateCount() + 1);
+
+        // Row 0 is a dead state and automaton state s is row s + 1, as in
+        // CompiledAutomaton.
+        columns = static_cast<uint32_t>(symbolCount + 1);
+        for (int c = 0; c < 256; ++c) {
+            FiniteAutomaton::SymbolId symbol = dfa.SymbolOf(static_cast<char>(c));
+            byteColumn[c] = symbol == FiniteAutomaton::None ? columns - 1 : symbol;
+        }
+        std::vector<uint32_t> next(rows * columns, 0);
+        accepting.assign(rows, 0);
+        for (FiniteAutomaton::StateId state = 0; state < dfa.StateCount(); ++state) {
+            accepting[state + 1] = dfa.IsFinal(state);
+            for (FiniteAutomaton::SymbolId symbol = 0; symbol < symbolCount; ++symbol) {
+                FiniteAutomaton::StateId target = dfa.Next(state, symbol);
+                if (target != FiniteAutomaton::None) next[(state + 1) * columns + symbol] = target + 1;
+            }
+        }
+        start = dfa.Start() + 1;
+
+        table.resize(next.size());
+        for (size_t i = 0; i < next.size(); ++i) table[i] = next[i] * columns;
+
+        std::vector<unsigned char> symbolBytes;
+        for (int c = 0; c < 256; ++c)
+            if (byteColumn[c] != columns - 1) symbolBytes.push_back(static_cast<unsigned char>(c));
+        bool allOneCharacter = symbolBytes.size() == symbolCount;
+
+        if (rows <= 16 && allOneCharacter && symbolBytes.size() <= 8) {
+            for (unsigned char byte : symbolBytes) {
+                std::array<uint8_t, 16> shuffle{};
+                for (uint32_t row = 0; row < rows; ++row)
+                    shuffle[row] = static_cast<uint8_t>(next[row * columns + byteColumn[byte]]);
+                shuffleBytes.push_back(byte);
+                shuffleTables.push_back(shuffle);
+            }
+        }
+        if (rows <= 4096) {
+            wideTable.assign(rows * 256, 0);
+            for (uint32_t row = 0; row < rows; ++row)
+                for (int c = 0; c < 256; ++c) wideTable[row * 256 + c] = next[row * columns + byteColumn[c]] * 256;
+        }
+    }
+
+    // The fastest kernel this automaton and this CPU allow.
+    Kernel Best() const {
+        if (Supports(Kernel::Shuffle)) return Kernel::Shuffle;
+        if (Supports(Kernel::Gather)) return Kernel::Gather;
+        return Kernel::Scalar;
+    }
+
+    bool Supports(Kernel kernel) const {
+        switch (kernel) {
+            case Kernel::Scalar: return true;
+            case Kernel::Shuffle: return HasAvx2() && !shuffleTables.empty();
+            case Kernel::Gather: return HasAvx2() && !wideTable.empty();
+        }
+        return false;
+    }
+
+    bool Accepts(std::string_view input) const {
+        return accepting[Finish(start * columns, input) / columns] != 0;
+    }
+
+    AcceptBitmap Accepts(const std::string_view* inputs, size_t count) const {
+        return Accepts(inputs, count, Best());
+    }
+
+    AcceptBitmap Accepts(const std::vector<std::string_view>& inputs) const {
+        return Accepts(inputs.data(), inputs.size(), Best());
+    }
+
+    // Runs the given kernel, which must be supported.
+    AcceptBitmap Accepts(const std::string_view* inputs, size_t count, Kernel kernel) const {
+        AcceptBitmap result;
+        result.size = count;
+        result.words.assign((count + 63) / 64, 0);
+        auto set = [&](size_t i, uint32_t state) {
+            if (accepting[state / columns]) result.words[i / 64] |= uint64_t(1) << (i % 64);
+        };
+
+        if (kernel == Kernel::Scalar || count < Lanes) {
+            for (size_t i = 0; i < count; ++i) set(i, Finish(start * columns, inputs[i]));
+            return result;
+        }
+
+        std::vector<uint32_t> order = ByBlocks(inputs, count);
+        size_t i = 0;
+        for (; i + Lanes <= count; i += Lanes) {
+            const char* lanes[Lanes];
+            uint32_t states[Lanes];
+            for (size_t lane = 0; lane < Lanes; ++lane) lanes[lane] = inputs[order[i + lane]].data();
+            size_t blocks = inputs[order[i]].size() / 16;
+#if MULTI_STREAM_X86
+            if (kernel == Kernel::Shuffle) RunShuffle(lanes, blocks, states);
+            else RunGather(lanes, blocks, states);
+#else
+            blocks = 0;
+            std::fill(states, states + Lanes, start * columns);
+#endif
+            for (size_t lane = 0; lane < Lanes; ++lane) {
+                uint32_t index = order[i + lane];
+                set(index, Finish(states[lane], inputs[index].substr(blocks * 16)));
+            }
+        }
+        for (; i < count; ++i) set(order[i], Finish(start * columns, inputs[order[i]]));
+        return result;
+    }
+
+private:
+    uint32_t rows = 0;
+    uint32_t columns = 0;
+    uint32_t start = 0;
+    std::array<uint32_t, 256> byteColumn{};
+    std::vector<uint32_t> table;      // [row * columns + column] = next row * columns
+    std::vector<uint8_t> accepting;   // by row
+    std::vector<unsigned char> shuffleBytes;
+    std::vector<std::array<uint8_t, 16>> shuffleTables;  // per symbol byte: next row by row
+    std::vector<uint32_t> wideTable;  // [row * 256 + byte] = next row * 256
+
+    static bool HasAvx2() {
+#if MULTI_STREAM_X86
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+
+    // Input indices ordered by the number of whole 16-byte blocks, which is
+    // all the lanes of a group need to agree on. A counting sort unless
+    // some input is very long.
+    static std::vector<uint32_t> ByBlocks(const std::string_view* inputs, size_t count) {
+        std::vector<uint32_t> order(count);
+        size_t maxBlocks = 0;
+        for (size_t i = 0; i < count; ++i) maxBlocks = std::max(maxBlocks, inputs[i].size() / 16);
+        if (maxBlocks > (size_t(1) << 16)) {
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) {
+                return inputs[x].size() / 16 < inputs[y].size() / 16;
+            });
+            return order;
+        }
+        std::vector<uint32_t> position(maxBlocks + 2, 0);
+        for (size_t i = 0; i < count; ++i) position[inputs[i].size() / 16 + 1]++;
+        for (size_t b = 0; b + 1 < position.size(); ++b) position[b + 1] += position[b];
+        for (size_t i = 0; i < count; ++i) order[position[inputs[i].size() / 16]++] = static_cast<uint32_t>(i);
+        return order;
+    }
+
+    // Continues the scalar walk from state (a row offset into table).
+    uint32_t Finish(uint32_t state, std::string_view rest) const {
+        const uint32_t* next = table.data();
+        for (char c : rest) {
+            state = next[state + byteColumn[static_cast<unsigned char>(c)]];
+            if (state == 0) break;
+        }
+        return state;
+    }
+
+#if MULTI_STREAM_X86
+    // Loads 16 bytes at offset from each of the 32 lanes and transposes
+    // them: afterwards bytes[t] holds byte t of lanes 0-15 in its low half
+    // and of lanes 16-31 in its high half.
+    MULTI_STREAM_AVX2 static void LoadBlock(const char* const* lanes, size_t offset, __m256i* bytes) {
+        for (int lane = 0; lane < 16; ++lane) {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[lane] + offset));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[lane + 16] + offset));
+            bytes[lane] = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        }
+        // Each round maps the index bits (row, column) = r3r2r1r0 c3c2c1c0 to
+        // r2r1r0c3 c2c1c0r3; four rounds swap row and column.
+        __m256i tmp[16];
+        for (int round = 0; round < 4; ++round) {
+            for (int i = 0; i < 8; ++i) {
+                tmp[2 * i] = _mm256_unpacklo_epi8(bytes[i], bytes[i + 8]);
+                tmp[2 * i + 1] = _mm256_unpackhi_epi8(bytes[i], bytes[i + 8]);
+            }
+            std::copy(tmp, tmp + 16, bytes);
+        }
+    }
+
+    MULTI_STREAM_AVX2 void RunShuffle(const char* const* lanes, size_t blocks, uint32_t* states) const {
+        const size_t symbols = shuffleTables.size();
+        __m256i tables[8], symbolBytes[8];
+        for (size_t s = 0; s < symbols; ++s) {
+            __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffleTables[s].data()));
+            tables[s] = _mm256_broadcastsi128_si256(row);
+            symbolBytes[s] = _mm256_set1_epi8(static_cast<char>(shuffleBytes[s]));
+        }
+
+        __m256i state = _mm256_set1_epi8(static_cast<char>(start));
+        __m256i bytes[16];
+        for (size_t block = 0; block < blocks; ++block) {
+            LoadBlock(lanes, block * 16, bytes);
+            for (int t = 0; t < 16; ++t) {
+                __m256i next = _mm256_setzero_si256();
+                for (size_t s = 0; s < symbols; ++s) {
+                    __m256i match = _mm256_cmpeq_epi8(bytes[t], symbolBytes[s]);
+                    next = _mm256_or_si256(next, _mm256_and_si256(match, _mm256_shuffle_epi8(tables[s], state)));
+                }
+                state = next;
+            }
+        }
+
+        alignas(32) uint8_t out[Lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), state);
+        for (size_t lane = 0; lane < Lanes; ++lane) states[lane] = out[lane] * columns;
+    }
+
+    MULTI_STREAM_AVX2 void RunGather(const char* const* lanes, size_t blocks, uint32_t* states) const {
+        const int* wide = reinterpret_cast<const int*>(wideTable.data());
+        // Lanes 0-7, 8-15, 16-23 and 24-31, as row * 256.
+        __m256i state[4];
+        for (auto& s : state) s = _mm256_set1_epi32(static_cast<int>(start * 256));
+        __m256i bytes[16];
+        for (size_t block = 0; block < blocks; ++block) {
+            LoadBlock(lanes, block * 16, bytes);
+            for (int t = 0; t < 16; ++t) {
+                __m128i low = _mm256_castsi256_si128(bytes[t]);
+                __m128i high = _mm256_extracti128_si256(bytes[t], 1);
+                __m256i index[4] = {
+                    _mm256_cvtepu8_epi32(low),
+                    _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)),
+                    _mm256_cvtepu8_epi32(high),
+                    _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)),
+                };
+                for (int k = 0; k < 4; ++k)
+                    state[k] = _mm256_i32gather_epi32(wide, _mm256_add_epi32(state[k], index[k]), 4);
+            }
+        }
+
+        alignas(32) uint32_t out[Lanes];
+        for (int k = 0; k < 4; ++k) _mm256_store_si256(reinterpret_cast<__m256i*>(out + 8 * k), state[k]);
+        for (size_t lane = 0; lane < Lanes; ++lane) states[lane] = out[lane] / 256 * columns;
+    }
+#endif
+};
+
+#endif
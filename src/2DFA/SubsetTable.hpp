@@ -0,0 +1,94 @@
+#ifndef SUBSET_TABLE_H
+#define SUBSET_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+inline int CountTrailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Numbers sets of NFA states in the order they are first inserted. Each set
+// is a bitset of a fixed number of words; the bitsets are stored back to back
+// and found again through an open-addressing table with linear probing.
+class SubsetTable {
+public:
+    static constexpr uint32_t Empty = UINT32_MAX;
+
+    explicit SubsetTable(size_t words) : words(words), slots(1024, Empty) {}
+
+    size_t Size() const { return hashes.size(); }
+    size_t Words() const { return words; }
+    const uint64_t* Subset(uint32_t id) const { return bits.data() + static_cast<size_t>(id) * words; }
+
+    // Returns the number of the subset and whether it was new. The subset
+    // must not point into this table.
+    std::pair<uint32_t, bool> Insert(const uint64_t* subset) {
+        uint64_t hash = Hash(subset);
+        size_t slot = Find(subset, hash);
+        if (slots[slot] != Empty) return {slots[slot], false};
+
+        uint32_t id = static_cast<uint32_t>(hashes.size());
+        hashes.push_back(hash);
+        bits.insert(bits.end(), subset, subset + words);
+        slots[slot] = id;
+        if (hashes.size() * 2 > slots.size()) Grow();
+        return {id, true};
+    }
+
+    // Forgets every subset but keeps the memory.
+    void Clear() {
+        std::fill(slots.begin(), slots.end(), Empty);
+        hashes.clear();
+        bits.clear();
+    }
+
+private:
+    size_t words;
+    std::vector<uint32_t> slots;
+    std::vector<uint64_t> hashes;
+    std::vector<uint64_t> bits;
+
+    uint64_t Hash(const uint64_t* subset) const {
+        uint64_t hash = 0;
+        for (size_t w = 0; w < words; ++w) hash = (hash ^ subset[w]) * 0x9e3779b97f4a7c15ull;
+        // The multiply only carries bits upward and slots come from the low
+        // bits, so finish with fmix64 to let every state reach the slot.
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        return hash ^ (hash >> 33);
+    }
+
+    // The slot holding subset, or the empty slot where it belongs.
+    size_t Find(const uint64_t* subset, uint64_t hash) const {
+        size_t mask = slots.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            uint32_t id = slots[slot];
+            if (id == Empty) return slot;
+            if (hashes[id] == hash && std::equal(subset, subset + words, Subset(id))) return slot;
+        }
+    }
+
+    void Grow() {
+        std::vector<uint32_t> old(slots.size() * 2, Empty);
+        slots.swap(old);
+        size_t mask = slots.size() - 1;
+        for (uint32_t id = 0; id < hashes.size(); ++id) {
+            size_t slot = hashes[id] & mask;
+            while (slots[slot] != Empty) slot = (slot + 1) & mask;
+            slots[slot] = id;
+        }
+    }
+};
+
+#endif
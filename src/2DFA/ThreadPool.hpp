@@ -0,0 +1,110 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads for data-parallel loops. The thread calling
+// ParallelFor works on the loop too, so a pool of size 1 has no workers and
+// runs everything inline.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        for (size_t i = 1; i < threads; ++i) workers.emplace_back([this] { Work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    size_t Size() const { return workers.size() + 1; }
+
+    // Calls body(begin, end) for consecutive ranges of at most grain indices
+    // that together cover [0, count), spread over the pool. Returns once all
+    // ranges are done and rethrows the first exception a range threw.
+    template <typename Body>
+    void ParallelFor(size_t count, size_t grain, Body&& body) {
+        grain = std::max<size_t>(grain, 1);
+        const size_t ranges = (count + grain - 1) / grain;
+        if (ranges == 0) return;
+
+        std::atomic<size_t> nextRange{0};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto run = [&] {
+            for (size_t range; (range = nextRange.fetch_add(1)) < ranges;) {
+                try {
+                    body(range * grain, std::min(count, (range + 1) * grain));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+            }
+        };
+
+        size_t helpers = std::min(workers.size(), ranges - 1);
+        size_t pending = helpers;
+        std::mutex doneMutex;
+        std::condition_variable done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < helpers; ++i) {
+                jobs.push([&] {
+                    run();
+                    std::lock_guard<std::mutex> doneLock(doneMutex);
+                    if (--pending == 0) done.notify_one();
+                });
+            }
+        }
+        wake.notify_all();
+
+        run();
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait(lock, [&] { return pending == 0; });
+        if (error) std::rethrow_exception(error);
+    }
+
+    // One pool per process, as wide as the machine.
+    static ThreadPool& Default() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void Work() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop();
+            }
+            job();
+        }
+    }
+};
+
+#endif
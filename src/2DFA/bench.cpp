@@ -0,0 +1,395 @@
+// Benchmarks for the automaton code. Build and run from this directory:
+//   g++ -std=c++17 -O2 -pthread -o bench bench.cpp
+//   ./bench [nfa|subset|minimize|batch|simd] [states]
+//   ./bench parallel [megabytes]
+//   ./bench lazy [k]
+#include "FiniteAutomaton.hpp"
+#include "BitParallelMatcher.hpp"
+#include "CompiledAutomaton.hpp"
+#include "ThreadPool.hpp"
+#include "MultiStreamDfa.hpp"
+#include "LazyDfa.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Each state gets `fanout` random successors per symbol; about a quarter of
+// the states are final.
+FiniteAutomaton randomAutomaton(int stateCount, const std::string& symbols, int fanout, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::unordered_set<std::string> states, alphabet, finals;
+    FiniteAutomaton::TransitionMap transitions;
+    for (int i = 0; i < stateCount; ++i) {
+        std::string state = "q" + std::to_string(i);
+        states.insert(state);
+        if (rng() % 4 == 0) finals.insert(state);
+        for (char c : symbols) {
+            auto& targets = transitions[state][std::string(1, c)];
+            for (int k = 0; k < fanout; ++k) targets.insert("q" + std::to_string(rng() % stateCount));
+        }
+    }
+    for (char c : symbols) alphabet.insert(std::string(1, c));
+    return FiniteAutomaton(states, alphabet, transitions, "q0", finals);
+}
+
+// Every state has one random successor per symbol and, one time in eight, a
+// second one; a quarter of the states are final. With 64 states and seed 2 the subset construction reaches
+// about 100k DFA states.
+FiniteAutomaton sparseRandomNfa(size_t stateCount, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<FiniteAutomaton::Edge> edges;
+    for (uint32_t state = 0; state < stateCount; ++state) {
+        for (uint32_t symbol = 0; symbol < 2; ++symbol) {
+            edges.push_back({state, symbol, static_cast<uint32_t>(rng() % stateCount)});
+            if (rng() % 8 == 0) edges.push_back({state, symbol, static_cast<uint32_t>(rng() % stateCount)});
+        }
+    }
+    std::vector<uint8_t> finals(stateCount);
+    for (auto& final : finals) final = rng() % 4 == 0;
+    return FiniteAutomaton::FromEdges({"a", "b"}, stateCount, std::move(edges), 0, std::move(finals));
+}
+
+// (a|b)*a(a|b)^k: k + 2 states whose DFA needs 2^(k+1).
+FiniteAutomaton nthFromLastNfa(uint32_t k) {
+    std::vector<FiniteAutomaton::Edge> edges = {{0, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (uint32_t state = 1; state <= k; ++state) {
+        edges.push_back({state, 0, state + 1});
+        edges.push_back({state, 1, state + 1});
+    }
+    std::vector<uint8_t> finals(k + 2, 0);
+    finals[k + 1] = 1;
+    return FiniteAutomaton::FromEdges({"a", "b"}, k + 2, std::move(edges), 0, std::move(finals));
+}
+
+// The same pattern on the top k + 2 of 64 states, with every lower state
+// active after the first symbol: the DFA states differ only in high bits.
+FiniteAutomaton highNthFromLastNfa(uint32_t k) {
+    const uint32_t low = 64 - (k + 2);
+    std::vector<FiniteAutomaton::Edge> edges = {{low, 0, low}, {low, 1, low}, {low, 0, low + 1}};
+    for (uint32_t state = low + 1; state <= low + k; ++state) {
+        edges.push_back({state, 0, state + 1});
+        edges.push_back({state, 1, state + 1});
+    }
+    for (uint32_t state = 0; state < low; ++state) {
+        for (uint32_t symbol = 0; symbol < 2; ++symbol) {
+            edges.push_back({low, symbol, state});
+            edges.push_back({state, symbol, state});
+        }
+    }
+    std::vector<uint8_t> finals(64, 0);
+    finals[63] = 1;
+    return FiniteAutomaton::FromEdges({"a", "b"}, 64, std::move(edges), low, std::move(finals));
+}
+
+std::vector<std::string> randomStrings(size_t count, size_t length, const std::string& symbols, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> result(count);
+    for (auto& s : result) {
+        s.resize(length);
+        for (auto& c : s) c = symbols[rng() % symbols.size()];
+    }
+    return result;
+}
+
+// Strings that follow the transitions of a DFA, so that a walk over them
+// rarely dies early. Lengths vary between length and twice that.
+std::vector<std::string> walkStrings(const FiniteAutomaton& dfa, size_t count, size_t length, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> result(count);
+    std::vector<FiniteAutomaton::SymbolId> moves;
+    for (auto& s : result) {
+        size_t size = length + rng() % (length + 1);
+        FiniteAutomaton::StateId state = dfa.Start();
+        while (s.size() < size) {
+            moves.clear();
+            for (FiniteAutomaton::SymbolId symbol = 0; symbol < dfa.SymbolCount(); ++symbol)
+                if (dfa.Next(state, symbol) != FiniteAutomaton::None) moves.push_back(symbol);
+            if (moves.empty()) break;
+            FiniteAutomaton::SymbolId symbol = moves[rng() % moves.size()];
+            s += dfa.SymbolName(symbol);
+            state = dfa.Next(state, symbol);
+        }
+    }
+    return result;
+}
+
+// The automaton of lab 1, variant 23: S -aB, B -aC | bB, C -bB | c | aS.
+FiniteAutomaton lab1Automaton() {
+    FiniteAutomaton::TransitionMap transitions = {
+        {"S", {{"a", {"B"}}}},
+        {"B", {{"a", {"C"}}, {"b", {"B"}}}},
+        {"C", {{"b", {"B"}}, {"c", {"C"}}, {"a", {"S"}}}},
+    };
+    return FiniteAutomaton({"S", "B", "C"}, {"a", "b", "c"}, transitions, "S", {"C"});
+}
+
+template <typename F>
+double secondsFor(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double seconds, size_t strings, size_t length) {
+    std::cout << "  " << name << ": " << seconds * 1000 << " ms, "
+              << strings / seconds << " strings/s, "
+              << strings * length / seconds / 1e6 << " Msymbols/s\n";
+}
+
+int benchNfa(int stateCount) {
+    const std::string symbols = "ab";
+    const size_t length = 64;
+    FiniteAutomaton nfa = randomAutomaton(stateCount, symbols, 2, 1);
+    BitParallelMatcher matcher(nfa);
+    auto inputs = randomStrings(500, length, symbols, 2);
+
+    std::cout << "nfa: " << stateCount << " states, " << inputs.size() << " strings of " << length << " symbols\n";
+    std::vector<char> expected, actual;
+    report("StringBelongsToLanguage", secondsFor([&] {
+        for (const auto& s : inputs) expected.push_back(nfa.StringBelongsToLanguage(s));
+    }), inputs.size(), length);
+    report("BitParallelMatcher", secondsFor([&] {
+        for (const auto& s : inputs) actual.push_back(matcher.Accepts(s));
+    }), inputs.size(), length);
+
+    if (actual != expected) {
+        std::cerr << "BitParallelMatcher disagrees with StringBelongsToLanguage\n";
+        return 1;
+    }
+    return 0;
+}
+
+int benchSubset(int stateCount) {
+    FiniteAutomaton nfa = sparseRandomNfa(stateCount, 2);
+    FiniteAutomaton dfa = nfa;
+    double seconds = secondsFor([&] { dfa = nfa.ConvertToDFA(); });
+    std::cout << "subset: " << stateCount << " NFA states -> " << dfa.StateCount() << " DFA states in "
+              << seconds * 1000 << " ms\n";
+
+    for (const auto& s : randomStrings(2000, 40, "ab", 3)) {
+        if (dfa.StringBelongsToLanguage(s) != nfa.StringBelongsToLanguage(s)) {
+            std::cerr << "ConvertToDFA changed the language\n";
+            return 1;
+        }
+    }
+
+    for (uint32_t k : {14u, 16u}) {
+        nfa = highNthFromLastNfa(k);
+        seconds = secondsFor([&] { dfa = nfa.ConvertToDFA(); });
+        std::cout << "subset: (a|b)*a(a|b)^" << k << " on states " << 62 - k << ".." << 63 << " -> "
+                  << dfa.StateCount() << " DFA states in " << seconds * 1000 << " ms\n";
+    }
+    return 0;
+}
+
+int benchMinimize(int stateCount) {
+    FiniteAutomaton dfa = sparseRandomNfa(stateCount, 2).ConvertToDFA();
+    FiniteAutomaton minimal = dfa;
+    double seconds = secondsFor([&] { minimal = dfa.Minimize(); });
+    std::cout << "minimize: " << dfa.StateCount() << " -> " << minimal.StateCount() << " states in "
+              << seconds * 1000 << " ms\n";
+
+    bool equivalent = false;
+    seconds = secondsFor([&] { equivalent = minimal.Equivalent(dfa); });
+    std::cout << "  Equivalent: " << (equivalent ? "yes" : "no") << " in " << seconds * 1000 << " ms\n";
+    return equivalent ? 0 : 1;
+}
+
+int benchBatch(int stateCount) {
+    FiniteAutomaton dfa = sparseRandomNfa(stateCount, 2).Minimize();
+    CompiledAutomaton compiled(dfa);
+    const size_t length = 32;
+    auto strings = randomStrings(1000000, length, "ab", 4);
+    std::vector<std::string_view> inputs(strings.begin(), strings.end());
+    std::cout << "batch: " << dfa.StateCount() << "-state DFA, " << inputs.size() << " strings of " << length << " symbols\n";
+
+    std::vector<char> expected;
+    report("StringBelongsToLanguage", secondsFor([&] {
+        for (const auto& s : strings) expected.push_back(dfa.StringBelongsToLanguage(s));
+    }), inputs.size(), length);
+    AcceptBitmap accepted;
+    for (size_t threads : {size_t(1), size_t(2), size_t(4), ThreadPool::Default().Size()}) {
+        ThreadPool pool(threads);
+        std::string name = "Accepts batch, " + std::to_string(threads) + " threads";
+        report(name.c_str(), secondsFor([&] { accepted = compiled.Accepts(inputs, pool); }), inputs.size(), length);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (accepted[i] != static_cast<bool>(expected[i])) {
+                std::cerr << "batch Accepts disagrees with StringBelongsToLanguage\n";
+                return 1;
+            }
+        }
+    }
+
+    const char* path = "bench_lines.txt";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (size_t i = 0; i < strings.size(); ++i) out << strings[i] << (i % 3 ? "\n" : "\r\n");
+    }
+    LineCounts counts;
+    report("CountFile", secondsFor([&] { counts = compiled.CountFile(path); }), inputs.size(), length);
+    std::remove(path);
+    if (counts.accepted != accepted.Count() || counts.accepted + counts.rejected != inputs.size()) {
+        std::cerr << "CountFile disagrees with batch Accepts\n";
+        return 1;
+    }
+    std::cout << "  accepted " << counts.accepted << ", rejected " << counts.rejected << "\n";
+    return 0;
+}
+
+int benchSimdOn(const char* name, const FiniteAutomaton& dfa) {
+    MultiStreamDfa matcher(dfa);
+    CompiledAutomaton compiled(dfa);
+    const size_t length = 64;
+    auto strings = walkStrings(dfa, 200000, length, 5);
+    std::vector<std::string_view> inputs(strings.begin(), strings.end());
+    size_t symbols = 0;
+    for (const auto& s : strings) symbols += s.size();
+    std::cout << "simd: " << name << ", " << dfa.StateCount() << " states, " << inputs.size()
+              << " strings of " << length << "-" << 2 * length << " symbols\n";
+
+    auto run = [&](const char* kernel, auto&& accepts) {
+        AcceptBitmap result;
+        double seconds = secondsFor([&] { result = accepts(); });
+        std::cout << "  " << kernel << ": " << inputs.size() / seconds << " strings/s, "
+                  << symbols / seconds / 1e6 << " Msymbols/s\n";
+        return result;
+    };
+    ThreadPool single(1);
+    AcceptBitmap expected = run("CompiledAutomaton", [&] { return compiled.Accepts(inputs, single); });
+    const std::pair<MultiStreamDfa::Kernel, const char*> kernels[] = {
+        {MultiStreamDfa::Kernel::Scalar, "scalar"},
+        {MultiStreamDfa::Kernel::Shuffle, "shuffle (AVX2)"},
+        {MultiStreamDfa::Kernel::Gather, "gather (AVX2)"},
+    };
+    for (const auto& [kernel, kernelName] : kernels) {
+        if (!matcher.Supports(kernel)) {
+            std::cout << "  " << kernelName << ": not available\n";
+            continue;
+        }
+        AcceptBitmap actual = run(kernelName, [&] { return matcher.Accepts(inputs.data(), inputs.size(), kernel); });
+        if (actual.words != expected.words) {
+            std::cerr << kernelName << " kernel disagrees with CompiledAutomaton\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int benchSimd(int stateCount) {
+    FiniteAutomaton lab1 = lab1Automaton();
+    FiniteAutomaton random = sparseRandomNfa(stateCount, 2).Minimize();
+    if (int failed = benchSimdOn("lab 1 automaton", lab1)) return failed;
+    if (int failed = benchSimdOn("minimized random NFA", random)) return failed;
+    return 0;
+}
+
+int benchParallelOn(const char* name, const FiniteAutomaton& dfa, size_t megabytes) {
+    CompiledAutomaton compiled(dfa);
+    std::string input = walkStrings(dfa, 1, megabytes << 20, 6)[0];
+    input.resize(megabytes << 20, dfa.SymbolName(0)[0]);
+    std::cout << "parallel: " << name << ", " << dfa.StateCount() << " states, " << megabytes << " MB input\n";
+
+    bool expected = false;
+    double sequential = secondsFor([&] { expected = compiled.Accepts(input); });
+    std::cout << "  sequential: " << input.size() / sequential / 1e6 << " MB/s\n";
+    const size_t hardware = ThreadPool::Default().Size();
+    for (size_t threads : {size_t(2), size_t(4), hardware}) {
+        ThreadPool pool(threads);
+        for (size_t chunk : {size_t(64) << 10, size_t(1) << 20, size_t(8) << 20}) {
+            bool actual = false;
+            double seconds = secondsFor([&] { actual = compiled.AcceptsParallel(input, pool, chunk); });
+            std::cout << "  " << threads << " threads, " << (chunk >> 10) << " KB chunks: "
+                      << input.size() / seconds / 1e6 << " MB/s (" << sequential / seconds << "x)\n";
+            if (actual != expected) {
+                std::cerr << "AcceptsParallel disagrees with Accepts\n";
+                return 1;
+            }
+        }
+        if (threads == hardware) break;
+    }
+    return 0;
+}
+
+int benchParallel(int megabytes) {
+    if (int failed = benchParallelOn("lab 1 automaton", lab1Automaton(), megabytes)) return failed;
+    if (int failed = benchParallelOn("minimized random NFA", sparseRandomNfa(12, 2).Minimize(), megabytes)) return failed;
+    return benchParallelOn("minimized random NFA", sparseRandomNfa(64, 2).Minimize(), megabytes);
+}
+
+int benchLazyOn(const char* name, const FiniteAutomaton& nfa, bool eager) {
+    const size_t length = 64;
+    auto inputs = randomStrings(100000, length, "ab", 7);
+    std::cout << "lazy: " << name << ", " << nfa.StateCount() << " NFA states, " << inputs.size()
+              << " strings of " << length << " symbols\n";
+
+    BitParallelMatcher matcher(nfa);
+    std::vector<char> expected;
+    report("BitParallelMatcher", secondsFor([&] {
+        for (const auto& s : inputs) expected.push_back(matcher.Accepts(s));
+    }), inputs.size(), length);
+
+    if (eager) {
+        std::unique_ptr<CompiledAutomaton> compiled;
+        double build = secondsFor([&] { compiled = std::make_unique<CompiledAutomaton>(nfa.ConvertToDFA()); });
+        std::vector<char> actual;
+        double seconds = secondsFor([&] {
+            for (const auto& s : inputs) actual.push_back(compiled->Accepts(s));
+        });
+        std::cout << "  ConvertToDFA: built in " << build * 1000 << " ms, then "
+                  << inputs.size() * length / seconds / 1e6 << " Msymbols/s\n";
+        if (actual != expected) {
+            std::cerr << "ConvertToDFA disagrees with BitParallelMatcher\n";
+            return 1;
+        }
+    }
+
+    for (size_t budget : {size_t(64) << 10, size_t(1) << 20, size_t(64) << 20}) {
+        LazyDfa lazy(nfa, budget);
+        std::vector<char> actual;
+        double seconds = secondsFor([&] {
+            for (const auto& s : inputs) actual.push_back(lazy.Accepts(s));
+        });
+        const auto& stats = lazy.GetStats();
+        std::cout << "  LazyDfa, " << (budget >> 10) << " KB (" << lazy.Capacity() << " states): "
+                  << inputs.size() * length / seconds / 1e6 << " Msymbols/s, " << stats.statesBuilt
+                  << " states built, " << stats.flushes << " flushes, " << stats.fallbacks << " fallbacks\n";
+        if (actual != expected) {
+            std::cerr << "LazyDfa disagrees with BitParallelMatcher\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int benchLazy(int k) {
+    if (int failed = benchLazyOn("random NFA", sparseRandomNfa(64, 2), true)) return failed;
+    if (int failed = benchLazyOn("(a|b)*a(a|b)^10", nthFromLastNfa(10), true)) return failed;
+    std::string name = "(a|b)*a(a|b)^" + std::to_string(k);
+    return benchLazyOn(name.c_str(), nthFromLastNfa(static_cast<uint32_t>(k)), false);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "nfa";
+    int states = argc > 2 ? std::atoi(argv[2]) : 0;
+    if (mode == "nfa") return benchNfa(states ? states : 300);
+    if (mode == "subset") return benchSubset(states ? states : 64);
+    if (mode == "minimize") return benchMinimize(states ? states : 64);
+    if (mode == "batch") return benchBatch(states ? states : 64);
+    if (mode == "simd") return benchSimd(states ? states : 12);
+    if (mode == "parallel") return benchParallel(states ? states : 64);
+    if (mode == "lazy") return benchLazy(states ? states : 40);
+    std::cerr << "usage: bench [nfa|subset|minimize|batch|simd] [states]\n"
+              << "       bench parallel [megabytes]\n"
+              << "       bench lazy [k]\n";
+    return 2;
+}
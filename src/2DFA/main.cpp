@@ -1,7 +1,10 @@
 #include "FiniteAutomaton.hpp"
+#include "CompiledAutomaton.hpp"
+#include "LanguageSampler.hpp"
 #include <iostream>
 
-int main() {
+// With a file argument, only reports how many of its lines the DFA accepts.
+int main(int argc, char* argv[]) {
     // Define NDFA Variant 23
     std::unordered_set<std::string> states = {"q0", "q1", "q2"};
     std::unordered_set<std::string> alphabet = {"a", "b"};
@@ -16,9 +19,21 @@ int main() {
 
     FiniteAutomaton ndfa(states, alphabet, transitions, startState, finalStates);
 
+    if (argc > 1) {
+        CompiledAutomaton compiled(ndfa.Minimize());
+        try {
+            LineCounts counts = compiled.CountFile(argv[1]);
+            std::cout << "Accepted: " << counts.accepted << "\nRejected: " << counts.rejected << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     std::cout << "The automaton is " << (ndfa.IsDeterministic() ? "deterministic" : "non-deterministic") << "\n";
 
-    FiniteAutomaton dfa = ndfa.ConvertToDFA();
+    FiniteAutomaton dfa = ndfa.ConvertToDFA().Minimize();
     dfa.PrintDFA();
 
     Grammar grammar = ndfa.ToGrammar();
@@ -26,8 +41,20 @@ int main() {
 
     std::cout << "Generated strings: \n";
     auto generatedStrings = grammar.GenerateStrings();
-    for (const auto& str : generatedStrings) {
-        std::cout << str << " -> " << (dfa.StringBelongsToLanguage(str) ? "Valid" : "Invalid") << "\n";
+    CompiledAutomaton compiled(dfa);
+    std::vector<std::string_view> inputs(generatedStrings.begin(), generatedStrings.end());
+    AcceptBitmap accepted = compiled.Accepts(inputs);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::cout << inputs[i] << " -> " << (accepted[i] ? "Valid" : "Invalid") << "\n";
+    }
+
+    // The grammar's own generator favours short words; these are uniform
+    // among all words of one length.
+    const size_t sampleLength = 8;
+    LanguageSampler sampler(FiniteAutomaton::FromGrammar(grammar), sampleLength);
+    std::cout << "Words of length " << sampleLength << ": " << sampler.Count(sampleLength) << ", drawn uniformly:\n";
+    for (int i = 0; i < 5; ++i) {
+        if (auto word = sampler.Sample(sampleLength, Grammar::rng)) std::cout << *word << "\n";
     }
 
     dfa.ToDot();
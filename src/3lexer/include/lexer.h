@@ -1,25 +1,42 @@
 #pragma once
 #include "token.h"
+#include <istream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
 class Lexer {
 public:
     explicit Lexer(const std::string& input);
+    // Streaming mode: input is read in chunks of at most ChunkSize bytes
+    // and only the current token is kept once it has been lexed.
+    explicit Lexer(std::istream& in);
+
+    // Next valid token, END_OF_FILE at the end. In streaming mode its value
+    // is only valid until the next call.
+    Token next();
+    // Every token of an in-memory source; throws std::logic_error in
+    // streaming mode, where earlier values would not stay valid.
     std::vector<Token> tokenize();
     static void runREPL();
 
 private:
+    static constexpr size_t ChunkSize = 4096;
+
     std::string input;
+    std::istream* in = nullptr;
     size_t pos = 0;
+    size_t tokenStart = 0;
     int line = 1;
     int column = 1;
 
     Token nextToken();
+    bool ensure(size_t count);
+    size_t readChunk(char* buffer, size_t size);
     void skipWhitespace();
-    char peek() const;
-    char peekNext() const;
+    char peek();
+    char peekNext();
     char advance();
     bool match(char expected);
 
@@ -27,5 +44,5 @@ private:
     Token makeNumber();
     Token makeIdentifierOrKeyword();
     Token makeSymbol();
-    Token makeToken(TokenType type, const std::string& value);
+    Token makeToken(TokenType type, std::string_view value);
 };
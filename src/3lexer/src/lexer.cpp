@@ -1,5 +1,6 @@
 #include "../include/lexer.h"
 #include <iostream>
+#include <stdexcept>
 #include <unordered_map>
 #include <cctype>
 
@@ -7,20 +8,30 @@
 // === Lexer Core ===
 Lexer::Lexer(const std::string& input) : input(input) {}
 
+Lexer::Lexer(std::istream& in) : in(&in) {}
+
 std::vector<Token> Lexer::tokenize() {
+    if (in) throw std::logic_error("tokenize() needs an in-memory source; use next() when streaming");
+
     std::vector<Token> tokens;
     while (true) {
-        Token token = nextToken();
-        if (token.type == TokenType::INVALID) continue;
-        tokens.push_back(token);
-        if (token.type == TokenType::END_OF_FILE) break;
+        tokens.push_back(next());
+        if (tokens.back().type == TokenType::END_OF_FILE) break;
     }
     return tokens;
 }
 
+Token Lexer::next() {
+    while (true) {
+        Token token = nextToken();
+        if (token.type != TokenType::INVALID) return token;
+    }
+}
+
 Token Lexer::nextToken() {
     skipWhitespace();
-    if (pos >= input.size()) return makeToken(TokenType::END_OF_FILE, "");
+    tokenStart = pos;
+    if (!ensure(1)) return makeToken(TokenType::END_OF_FILE, "");
 
     char c = peek();
     if (std::isalpha(c) || c == '_') return makeIdentifierOrKeyword();
@@ -29,16 +40,44 @@ Token Lexer::nextToken() {
     return makeSymbol();
 }
 
+// Makes sure count characters are available at pos, reading more chunks in
+// streaming mode. Text before the current token is dropped first, so the
+// buffer holds at most the current token and one chunk.
+bool Lexer::ensure(size_t count) {
+    while (pos + count > input.size()) {
+        if (!in) return false;
+        if (tokenStart > 0) {
+            input.erase(0, tokenStart);
+            pos -= tokenStart;
+            tokenStart = 0;
+        }
+        size_t size = input.size();
+        input.resize(size + ChunkSize);
+        input.resize(size + readChunk(&input[size], ChunkSize));
+        if (input.size() == size) return false;
+    }
+    return true;
+}
+
+// Waits for one character, then takes whatever else is already buffered, so
+// an interactive stream is lexed as each line arrives. Returns 0 at the end.
+size_t Lexer::readChunk(char* buffer, size_t size) {
+    int first = in->get();
+    if (first == std::char_traits<char>::eof()) return 0;
+    buffer[0] = static_cast<char>(first);
+    return 1 + static_cast<size_t>(in->readsome(buffer + 1, static_cast<std::streamsize>(size - 1)));
+}
+
 void Lexer::skipWhitespace() {
-    while (pos < input.size() && std::isspace(input[pos])) {
+    while (ensure(1) && std::isspace(input[pos])) {
         if (input[pos] == '\n') { line++; column = 1; }
         else { column++; }
-        pos++;
+        tokenStart = ++pos;
     }
 }
 
-char Lexer::peek() const { return pos < input.size() ? input[pos] : '\0'; }
-char Lexer::peekNext() const { return pos + 1 < input.size() ? input[pos + 1] : '\0'; }
+char Lexer::peek() { return ensure(1) ? input[pos] : '\0'; }
+char Lexer::peekNext() { return ensure(2) ? input[pos + 1] : '\0'; }
 char Lexer::advance() { column++; return input[pos++]; }
 
 bool Lexer::match(char expected) {
@@ -49,16 +88,15 @@ bool Lexer::match(char expected) {
     return false;
 }
 
-Token Lexer::makeToken(TokenType type, const std::string& value) {
+Token Lexer::makeToken(TokenType type, std::string_view value) {
     return Token(type, value, line, column);
 }
 
 Token Lexer::makeIdentifierOrKeyword() {
-    size_t start = pos;
     while (std::isalnum(peek()) || peek() == '_') advance();
-    std::string value = input.substr(start, pos - start);
+    std::string_view value = std::string_view(input).substr(tokenStart, pos - tokenStart);
 
-    static std::unordered_map<std::string, TokenType> keywords = {
+    static const std::unordered_map<std::string_view, TokenType> keywords = {
         {"LOAD", TokenType::LOAD}, {"FROM", TokenType::FROM}, {"SET", TokenType::SET},
         {"WINDOW", TokenType::WINDOW}, {"TREND", TokenType::TREND},
         {"FORECAST", TokenType::FORECAST}, {"USING", TokenType::USING},
@@ -75,13 +113,13 @@ Token Lexer::makeIdentifierOrKeyword() {
         {"Prophet", TokenType::PROPHET}, {"LSTM", TokenType::LSTM}
     };
 
-    if (keywords.count(value)) return makeToken(keywords[value], value);
+    auto keyword = keywords.find(value);
+    if (keyword != keywords.end()) return makeToken(keyword->second, value);
     if (value == "d" || value == "h" || value == "m") return makeToken(TokenType::TIME_UNIT, value);
     return makeToken(TokenType::ID, value);
 }
 
 Token Lexer::makeNumber() {
-    size_t start = pos;
     bool isFloat = false;
     while (std::isdigit(peek())) advance();
     if (peek() == '.' && std::isdigit(peekNext())) {
@@ -89,19 +127,19 @@ Token Lexer::makeNumber() {
         advance();
         while (std::isdigit(peek())) advance();
     }
-    std::string value = input.substr(start, pos - start);
+    std::string_view value = std::string_view(input).substr(tokenStart, pos - tokenStart);
     return makeToken(isFloat ? TokenType::FLOAT : TokenType::INT, value);
 }
 
 Token Lexer::makeString() {
     advance(); // skip opening "
-    size_t start = pos;
-    while (peek() != '"' && pos < input.size()) {
-        if (peek() == '\n') line++;
+    while (ensure(1) && input[pos] != '"') {
+        if (input[pos] == '\n') line++;
         advance();
     }
-    std::string value = input.substr(start, pos - start);
-    advance(); // skip closing "
+    std::string_view value = std::string_view(input).substr(tokenStart + 1, pos - tokenStart - 1);
+    if (ensure(1)) advance(); // skip closing "
+    else column++;
     return makeToken(TokenType::STRING, value);
 }
 
@@ -118,7 +156,7 @@ Token Lexer::makeSymbol() {
         case ',': return makeToken(TokenType::COMMA, ",");
         case '-': if (match('>')) return makeToken(TokenType::ARROW, "->"); break;
     }
-    return makeToken(TokenType::INVALID, std::string(1, c));
+    return makeToken(TokenType::INVALID, std::string_view(input).substr(pos - 1, 1));
 }
   
 static std::string tokenTypeToString(TokenType type) {
@@ -175,14 +213,13 @@ static std::string tokenTypeToString(TokenType type) {
 
 void Lexer::runREPL() {
     std::cout << "Enter ChronoLang code (Ctrl+D to end):\n";
-    std::string input, line;
-    while (std::getline(std::cin, line)) input += line + '\n';
-
-    Lexer lexer(input);
-    std::vector<Token> tokens = lexer.tokenize();
 
-    for (const auto& token : tokens) {
+    // Tokens are printed as soon as the line that ends them has been read.
+    Lexer lexer(std::cin);
+    while (true) {
+        Token token = lexer.next();
         std::cout << tokenTypeToString(token.type) << "('" << token.value << "')"
                   << " at line " << token.line << ", col " << token.column << "\n";
+        if (token.type == TokenType::END_OF_FILE) break;
     }
 }
@@ -0,0 +1,161 @@
+// Benchmarks for the regex generator. Build and run from this directory:
+//   g++ -std=c++17 -O2 -pthread -o bench bench.cpp
+//   ./bench [trace|generate|sample] [words]
+// Add -DREGEX_TRACE_LEVEL=0 to compare against tracing compiled out.
+#include "regex.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> sample_regexes = {
+    "O(P|Q2|R)^+2(3|4)",
+    "A^*B(C|D|E)F(G|H|I)^2",
+    "J^+K(L|M|N)^*0?(P|Q)^3"
+};
+
+template <typename F>
+double seconds_for(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, double seconds, size_t words, size_t bytes) {
+    std::cout << "  " << name << ": " << seconds * 1000 << " ms, "
+              << words / seconds / 1e6 << " Mwords/s, "
+              << bytes / seconds / 1e6 << " MB/s\n";
+}
+
+// Generates words with tracing off, with a sink that only takes SUMMARY
+// lines, and with every step traced into a buffer cleared per word.
+int bench_trace(size_t words) {
+    std::cout << "trace: " << words << " words per regex, REGEX_TRACE_LEVEL " << REGEX_TRACE_LEVEL << "\n";
+    for (const auto& regex : sample_regexes) {
+        auto ast = Parser(regex).parse();
+        std::cout << regex << "\n";
+
+        size_t bytes = 0;
+        double seconds = seconds_for([&] {
+            Xoshiro256 random(1);
+            Tracer tracer;
+            for (size_t i = 0; i < words; ++i) bytes += generate(ast, random, tracer).size();
+        });
+        report("off", seconds, words, bytes);
+
+        BufferTraceSink sink;
+        bytes = 0;
+        seconds = seconds_for([&] {
+            Xoshiro256 random(1);
+            Tracer tracer(sink, TraceLevel::SUMMARY);
+            for (size_t i = 0; i < words; ++i) bytes += generate(ast, random, tracer).size();
+        });
+        report("summary", seconds, words, bytes);
+
+        bytes = 0;
+        size_t trace_bytes = 0;
+        seconds = seconds_for([&] {
+            Xoshiro256 random(1);
+            Tracer tracer(sink, TraceLevel::STEPS);
+            for (size_t i = 0; i < words; ++i) {
+                sink.clear();
+                bytes += generate(ast, random, tracer).size();
+                trace_bytes += sink.str().size();
+            }
+        });
+        report("steps", seconds, words, bytes);
+        std::cout << "  (" << trace_bytes / words << " trace bytes per word)\n";
+    }
+    return 0;
+}
+
+// generate() against generate_n and generate_to_stream writing a file, on
+// one thread and on the default pool.
+int bench_generate(size_t words) {
+    std::cout << "generate: " << words << " words per regex\n";
+    const char* path = "bench_words.txt";
+    for (const auto& regex : sample_regexes) {
+        auto ast = Parser(regex).parse();
+        std::cout << regex << "\n";
+
+        size_t bytes = 0;
+        double seconds = seconds_for([&] {
+            Xoshiro256 random(1);
+            for (size_t i = 0; i < words; ++i) bytes += generate(ast, random).size();
+        });
+        report("generate", seconds, words, bytes);
+
+        bytes = 0;
+        seconds = seconds_for([&] {
+            generate_n(ast, words, [&](std::string_view word) { bytes += word.size(); });
+        });
+        report("generate_n", seconds, words, bytes);
+
+        for (size_t threads : {size_t(1), ThreadPool::Default().Size()}) {
+            ThreadPool pool(threads);
+            seconds = seconds_for([&] {
+                std::ofstream out(path, std::ios::binary);
+                generate_to_stream(ast, words, out, 1, pool);
+            });
+            std::string name = "generate_to_stream, " + std::to_string(threads) + " thread(s)";
+            report(name.c_str(), seconds, words, bytes + words);
+        }
+        std::remove(path);
+    }
+    return 0;
+}
+
+// Uniform sampling of words of one length against enumerating all words up
+// to that length.
+int bench_sample(size_t words) {
+    const size_t length = 12;
+    std::cout << "sample: " << words << " words of length " << length << " per regex\n";
+    for (const auto& regex : sample_regexes) {
+        auto ast = Parser(regex).parse();
+        std::unique_ptr<LanguageSampler> sampler;
+        double seconds = seconds_for([&] { sampler = std::make_unique<LanguageSampler>(compile(ast), length); });
+        std::cout << regex << ": " << sampler->Count(length) << " words of length " << length
+                  << ", tables built in " << seconds * 1000 << " ms\n";
+        if (sampler->Count(length) == 0) continue;
+
+        Xoshiro256 random(1);
+        std::string word;
+        size_t bytes = 0;
+        seconds = seconds_for([&] {
+            for (size_t i = 0; i < words; ++i) {
+                sampler->Sample(length, random, word);
+                bytes += word.size();
+            }
+        });
+        report("Sample", seconds, words, bytes);
+
+        size_t listed = 0;
+        bytes = 0;
+        seconds = seconds_for([&] {
+            sampler->Enumerate(length, [&](std::string_view w) {
+                ++listed;
+                bytes += w.size();
+            });
+        });
+        report("Enumerate", seconds, listed, bytes);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "trace";
+    size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    if (mode == "trace") return bench_trace(count ? count : 1000000);
+    if (mode == "generate") return bench_generate(count ? count : 10000000);
+    if (mode == "sample") return bench_sample(count ? count : 1000000);
+    std::cerr << "usage: bench [trace|generate|sample] [words]\n";
+    return 2;
+}
@@ -1,191 +1,130 @@
-#include <iostream>
-#include <string>
-#include <vector>
-#include <memory>
-#include <random>
+#include "regex.hpp"
 #include <ctime>
-#include <sstream>
-#include <cctype>
 
-const int MAX_REPETITION = 5;
-
-std::mt19937 rng(time(nullptr));
-
-int rand_int(int a, int b) {
-    std::uniform_int_distribution<int> dist(a, b);
-    return dist(rng);
-}
-
-std::ostringstream trace_log;
-
-void trace(const std::string& msg) {
-    trace_log << msg << "\n";
-}
-
-struct Node {
-    enum Type { LITERAL, SEQUENCE, ALTERNATION, REPETITION } type;
-    std::string value;
-    std::vector<std::shared_ptr<Node>> children;
-    int repeat_min = 1, repeat_max = 1;
-
-    Node(Type t) : type(t) {}
-};
-
-class Parser {
-    std::string regex;
-    size_t pos = 0;
-
-public:
-    Parser(std::string input) : regex(std::move(input)) {}
-
-    std::shared_ptr<Node> parse() {
-        trace("Start parsing: " + regex);
-        auto result = parse_sequence();
-        trace("Finished parsing.");
-        return result;
-    }
-
-private:
-    char peek() const {
-        return pos < regex.size() ? regex[pos] : '\0';
-    }
-
-    char get() {
-        return pos < regex.size() ? regex[pos++] : '\0';
+// The sampler for -l and -e. A pattern whose DFA does not fit in
+// DfaMemoryBudget is reported instead of determinized without bound.
+LanguageSampler make_sampler(const std::shared_ptr<Node>& ast, size_t length) {
+    try {
+        return LanguageSampler(compile(ast), length, DfaMemoryBudget);
+    } catch (const std::length_error& e) {
+        throw std::runtime_error(std::string("the pattern's DFA is too large to count words by length (") + e.what() +
+                                 ")");
     }
+}
 
-    bool match(char expected) {
-        if (peek() == expected) {
-            get();
-            return true;
+// regex <pattern>         prints the lines of stdin that match the pattern
+// regex <pattern> <file>  counts the lines of the file that match it
+int match_main(int argc, char* argv[]) {
+    try {
+        Matcher matcher(argv[1]);
+        if (argc > 2) {
+            LineCounts counts = matcher.count_file(argv[2]);
+            std::cout << "Accepted: " << counts.accepted << "\nRejected: " << counts.rejected << "\n";
+            return 0;
         }
-        return false;
-    }
-
-    std::shared_ptr<Node> parse_sequence(char until = '\0') {
-        auto seq_node = std::make_shared<Node>(Node::SEQUENCE);
-        trace("Begin sequence");
-        while (pos < regex.size() && peek() != until && peek() != '|') {
-            if (peek() == '(') {
-                get();
-                auto alt = parse_alternation();
-                if (!match(')')) throw std::runtime_error("Expected )");
-                apply_power(alt);
-                seq_node->children.push_back(alt);
-            } else {
-                auto lit = parse_literal();
-                apply_power(lit);
-                seq_node->children.push_back(lit);
-            }
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (matcher.matches(line)) std::cout << line << "\n";
         }
-        trace("End sequence");
-        if (seq_node->children.size() == 1) return seq_node->children[0];
-        return seq_node;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
     }
+    return 0;
+}
 
-    std::shared_ptr<Node> parse_alternation() {
-        trace("Begin alternation");
-        auto alt_node = std::make_shared<Node>(Node::ALTERNATION);
-        alt_node->children.push_back(parse_sequence(')'));
-        while (match('|')) {
-            alt_node->children.push_back(parse_sequence(')'));
+// regex -n <count> [-s <seed>] [-l <length>] <pattern> [file]
+//   writes count random words, one per line, to the file or stdout; with -l
+//   they are drawn uniformly among the words of exactly that length
+int generate_main(int argc, char* argv[]) {
+    try {
+        size_t count = std::stoull(argv[2]);
+        uint64_t seed = static_cast<uint64_t>(time(nullptr));
+        std::optional<size_t> length;
+        int arg = 3;
+        for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+            std::string option = argv[arg];
+            if (option == "-s") seed = std::stoull(argv[arg + 1]);
+            else if (option == "-l") length = std::stoull(argv[arg + 1]);
+            else throw std::runtime_error("unknown option " + option);
         }
-        trace("End alternation");
-        return alt_node;
-    }
-
-    std::shared_ptr<Node> parse_literal() {
-        char c = get();
-        trace("Parsed literal: " + std::string(1, c));
-        auto node = std::make_shared<Node>(Node::LITERAL);
-        node->value = std::string(1, c);
-        return node;
-    }
-
-    void apply_power(std::shared_ptr<Node>& node) {
-        if (peek() == '^') {
-            get();
-            if (peek() == '+') {
-                get();
-                node->repeat_min = 1;
-                node->repeat_max = MAX_REPETITION;
-                trace("Applied ^+ to node");
-            } else if (peek() == '*') {
-                get();
-                node->repeat_min = 0;
-                node->repeat_max = MAX_REPETITION;
-                trace("Applied ^* to node");
-            } else {
-                std::string num;
-                while (isdigit(peek())) num += get();
-                int n = std::stoi(num);
-                node->repeat_min = node->repeat_max = n;
-                trace("Applied ^" + std::to_string(n) + " to node");
-            }
-            auto rep_node = std::make_shared<Node>(Node::REPETITION);
-            rep_node->repeat_min = node->repeat_min;
-            rep_node->repeat_max = node->repeat_max;
-            rep_node->children.push_back(node);
-            node = rep_node;
-        } else if (peek() == '?') {
-            get();
-            trace("Applied ? to node");
-            auto rep_node = std::make_shared<Node>(Node::REPETITION);
-            rep_node->repeat_min = 0;
-            rep_node->repeat_max = 1;
-            rep_node->children.push_back(node);
-            node = rep_node;
+        if (arg >= argc) throw std::runtime_error("missing pattern");
+        auto ast = Parser(argv[arg]).parse();
+
+        std::ofstream file;
+        if (arg + 1 < argc) {
+            file.open(argv[arg + 1], std::ios::binary);
+            if (!file) throw std::runtime_error(std::string("cannot open ") + argv[arg + 1]);
+        } else {
+            std::ios::sync_with_stdio(false);
         }
-    }
-};
+        std::ostream& out = arg + 1 < argc ? file : std::cout;
 
-std::string generate(const std::shared_ptr<Node>& node) {
-    switch (node->type) {
-        case Node::LITERAL:
-            trace("Generating literal: " + node->value);
-            return node->value;
-        case Node::SEQUENCE: {
-            trace("Generating sequence");
-            std::string result;
-            for (const auto& child : node->children)
-                result += generate(child);
-            return result;
-        }
-        case Node::ALTERNATION: {
-            int choice = rand_int(0, node->children.size() - 1);
-            trace("Generating alternation, chose option " + std::to_string(choice));
-            return generate(node->children[choice]);
+        if (!length) {
+            generate_to_stream(ast, count, out, seed);
+            return 0;
         }
-        case Node::REPETITION: {
-            int times = rand_int(node->repeat_min, node->repeat_max);
-            trace("Generating repetition, times = " + std::to_string(times));
-            std::string result;
-            for (int i = 0; i < times; ++i)
-                result += generate(node->children[0]);
-            return result;
+        LanguageSampler sampler = make_sampler(ast, *length);
+        if (sampler.Count(*length) == 0) throw std::runtime_error("no words of length " + std::to_string(*length));
+        Xoshiro256 random(seed);
+        std::string word;
+        for (size_t i = 0; i < count; ++i) {
+            sampler.Sample(*length, random, word);
+            word += '\n';
+            out.write(word.data(), static_cast<std::streamsize>(word.size()));
         }
+        if (!out) throw std::runtime_error("write failed");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// regex -e <max length> <pattern>
+//   lists every word of at most max length symbols in lexicographic order
+int enumerate_main(int argc, char* argv[]) {
+    try {
+        size_t length = std::stoull(argv[2]);
+        if (argc < 4) throw std::runtime_error("missing pattern");
+        LanguageSampler sampler = make_sampler(Parser(argv[3]).parse(), length);
+        std::ios::sync_with_stdio(false);
+        sampler.Enumerate(length, [](std::string_view word) { std::cout << word << '\n'; });
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
     }
-    return "";
+    return 0;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 2 && std::string(argv[1]) == "-n") return generate_main(argc, argv);
+    if (argc > 2 && std::string(argv[1]) == "-e") return enumerate_main(argc, argv);
+    if (argc > 1) return match_main(argc, argv);
+
     std::vector<std::string> regexes = {
         "O(P|Q2|R)^+2(3|4)",
         "A^*B(C|D|E)F(G|H|I)^2",
         "J^+K(L|M|N)^*0?(P|Q)^3"
     };
 
+    BufferTraceSink trace_log;
+    Xoshiro256 random(static_cast<uint64_t>(time(nullptr)));
     for (const auto& r : regexes) {
         try {
-            Parser parser(r);
+            Tracer tracer(trace_log);
+            Parser parser(r, tracer);
             auto ast = parser.parse();
-            std::string word = generate(ast);
-            std::cout << "Regex: " << r << " => " << word << "\n";
+            std::string word = generate(ast, random, tracer);
+            Matcher matcher(ast);
+            std::cout << "Regex: " << r << " => " << word << " ("
+                      << (matcher.matches(word) ? "matches" : "does not match") << ", "
+                      << matcher.state_count() << (matcher.uses_counters() ? " positions)\n" : " DFA states)\n");
             std::cout << "Trace:\n" << trace_log.str() << "\n";
         } catch (const std::exception& e) {
             std::cerr << "Error parsing regex '" << r << "': " << e.what() << "\n";
         }
-        trace_log.str("");
         trace_log.clear();
     }
 
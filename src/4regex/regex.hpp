@@ -0,0 +1,819 @@
+#ifndef REGEX_H
+#define REGEX_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cctype>
+#include <array>
+#include <fstream>
+#include <optional>
+#include <cstdint>
+#include <stdexcept>
+#include "../2DFA/FiniteAutomaton.hpp"
+#include "../2DFA/CompiledAutomaton.hpp"
+#include "../2DFA/ThreadPool.hpp"
+#include "../2DFA/LanguageSampler.hpp"
+
+const int MAX_REPETITION = 5;
+
+// Trace messages above REGEX_TRACE_LEVEL are compiled out; build with
+// -DREGEX_TRACE_LEVEL=0 to drop tracing entirely.
+#ifndef REGEX_TRACE_LEVEL
+#define REGEX_TRACE_LEVEL 2
+#endif
+
+enum class TraceLevel { OFF = 0, SUMMARY = 1, STEPS = 2 };
+
+// Where trace lines go. Each parser or generator call writes to the sink it
+// was given, so separate threads can trace into separate sinks.
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+    virtual void write(std::string_view line) = 0;
+};
+
+// Collects the lines in memory, each ending in "\n".
+class BufferTraceSink : public TraceSink {
+    std::string buffer;
+
+public:
+    void write(std::string_view line) override {
+        buffer.append(line);
+        buffer += '\n';
+    }
+
+    const std::string& str() const { return buffer; }
+    void clear() { buffer.clear(); }
+};
+
+class StreamTraceSink : public TraceSink {
+    std::ostream& out;
+
+public:
+    explicit StreamTraceSink(std::ostream& out) : out(out) {}
+    void write(std::string_view line) override { out << line << '\n'; }
+};
+
+// Formats a message only when its level is enabled, reusing one buffer.
+// Without a sink every call is a single branch.
+class Tracer {
+    TraceSink* sink = nullptr;
+    TraceLevel level = TraceLevel::OFF;
+    std::string line;
+
+public:
+    Tracer() = default;
+    explicit Tracer(TraceSink& sink, TraceLevel level = TraceLevel::STEPS) : sink(&sink), level(level) {}
+
+    template <TraceLevel Level, typename... Parts>
+    void trace(const Parts&... parts) {
+        if constexpr (static_cast<int>(Level) <= REGEX_TRACE_LEVEL) {
+            if (sink == nullptr || Level > level) return;
+            line.clear();
+            (append(parts), ...);
+            sink->write(line);
+        }
+    }
+
+private:
+    void append(std::string_view text) { line += text; }
+    void append(char c) { line += c; }
+    void append(int n) { line += std::to_string(n); }
+};
+
+struct Node {
+    enum Type { LITERAL, SEQUENCE, ALTERNATION, REPETITION } type;
+    std::string value;
+    std::vector<std::shared_ptr<Node>> children;
+    int repeat_min = 1, repeat_max = 1;
+
+    Node(Type t) : type(t) {}
+};
+
+class Parser {
+    std::string regex;
+    size_t pos = 0;
+    Tracer tracer;
+
+public:
+    Parser(std::string input, Tracer tracer = Tracer()) : regex(std::move(input)), tracer(std::move(tracer)) {}
+
+    std::shared_ptr<Node> parse() {
+        tracer.trace<TraceLevel::SUMMARY>("Start parsing: ", regex);
+        auto result = parse_sequence();
+        if (peek() == '|') {
+            auto alt_node = std::make_shared<Node>(Node::ALTERNATION);
+            alt_node->children.push_back(result);
+            while (match('|')) alt_node->children.push_back(parse_sequence());
+            result = alt_node;
+        }
+        tracer.trace<TraceLevel::SUMMARY>("Finished parsing.");
+        return result;
+    }
+
+private:
+    char peek() const {
+        return pos < regex.size() ? regex[pos] : '\0';
+    }
+
+    char get() {
+        return pos < regex.size() ? regex[pos++] : '\0';
+    }
+
+    bool match(char expected) {
+        if (peek() == expected) {
+            get();
+            return true;
+        }
+        return false;
+    }
+
+    std::shared_ptr<Node> parse_sequence(char until = '\0') {
+        auto seq_node = std::make_shared<Node>(Node::SEQUENCE);
+        tracer.trace<TraceLevel::STEPS>("Begin sequence");
+        while (pos < regex.size() && peek() != until && peek() != '|') {
+            if (peek() == '(') {
+                get();
+                auto alt = parse_alternation();
+                if (!match(')')) throw std::runtime_error("Expected )");
+                apply_power(alt);
+                seq_node->children.push_back(alt);
+            } else {
+                auto lit = parse_literal();
+                apply_power(lit);
+                seq_node->children.push_back(lit);
+            }
+        }
+        tracer.trace<TraceLevel::STEPS>("End sequence");
+        if (seq_node->children.size() == 1) return seq_node->children[0];
+        return seq_node;
+    }
+
+    std::shared_ptr<Node> parse_alternation() {
+        tracer.trace<TraceLevel::STEPS>("Begin alternation");
+        auto alt_node = std::make_shared<Node>(Node::ALTERNATION);
+        alt_node->children.push_back(parse_sequence(')'));
+        while (match('|')) {
+            alt_node->children.push_back(parse_sequence(')'));
+        }
+        tracer.trace<TraceLevel::STEPS>("End alternation");
+        return alt_node;
+    }
+
+    std::shared_ptr<Node> parse_literal() {
+        char c = get();
+        tracer.trace<TraceLevel::STEPS>("Parsed literal: ", c);
+        auto node = std::make_shared<Node>(Node::LITERAL);
+        node->value = std::string(1, c);
+        return node;
+    }
+
+    void apply_power(std::shared_ptr<Node>& node) {
+        if (peek() == '^') {
+            get();
+            if (peek() == '+') {
+                get();
+                node->repeat_min = 1;
+                node->repeat_max = MAX_REPETITION;
+                tracer.trace<TraceLevel::STEPS>("Applied ^+ to node");
+            } else if (peek() == '*') {
+                get();
+                node->repeat_min = 0;
+                node->repeat_max = MAX_REPETITION;
+                tracer.trace<TraceLevel::STEPS>("Applied ^* to node");
+            } else {
+                std::string num;
+                while (isdigit(peek())) num += get();
+                int n = std::stoi(num);
+                node->repeat_min = node->repeat_max = n;
+                tracer.trace<TraceLevel::STEPS>("Applied ^", n, " to node");
+            }
+            auto rep_node = std::make_shared<Node>(Node::REPETITION);
+            rep_node->repeat_min = node->repeat_min;
+            rep_node->repeat_max = node->repeat_max;
+            rep_node->children.push_back(node);
+            node = rep_node;
+        } else if (peek() == '?') {
+            get();
+            tracer.trace<TraceLevel::STEPS>("Applied ? to node");
+            auto rep_node = std::make_shared<Node>(Node::REPETITION);
+            rep_node->repeat_min = 0;
+            rep_node->repeat_max = 1;
+            rep_node->children.push_back(node);
+            node = rep_node;
+        }
+    }
+};
+
+// xoshiro256** seeded through splitmix64 from seed ^ splitmix64(stream).
+// The streams of one seed start from distinct states, since splitmix64 is a
+// bijection, and are only as independent as splitmix64's outputs; pairs with
+// different seeds can collide. The state depends on nothing else, so blocks
+// of words can be generated on any thread and still come out the same.
+class Xoshiro256 {
+    uint64_t s[4];
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    explicit Xoshiro256(uint64_t seed, uint64_t stream = 0) {
+        uint64_t x = stream;
+        x = seed ^ splitmix64(x);
+        for (auto& word : s) word = splitmix64(x);
+    }
+
+    uint64_t operator()() { return next(); }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [a, b] by multiply-shift; the bias is below 2^-32 per value.
+    int uniform(int a, int b) {
+        uint64_t range = static_cast<uint64_t>(b - a) + 1;
+        return a + static_cast<int>(((next() >> 32) * range) >> 32);
+    }
+};
+
+// One random word, traced step by step. The same seed gives the same word.
+inline std::string generate(const std::shared_ptr<Node>& node, Xoshiro256& random, Tracer& tracer) {
+    switch (node->type) {
+        case Node::LITERAL:
+            tracer.trace<TraceLevel::STEPS>("Generating literal: ", node->value);
+            return node->value;
+        case Node::SEQUENCE: {
+            tracer.trace<TraceLevel::STEPS>("Generating sequence");
+            std::string result;
+            for (const auto& child : node->children)
+                result += generate(child, random, tracer);
+            return result;
+        }
+        case Node::ALTERNATION: {
+            int choice = random.uniform(0, static_cast<int>(node->children.size()) - 1);
+            tracer.trace<TraceLevel::STEPS>("Generating alternation, chose option ", choice);
+            return generate(node->children[choice], random, tracer);
+        }
+        case Node::REPETITION: {
+            int times = random.uniform(node->repeat_min, node->repeat_max);
+            tracer.trace<TraceLevel::STEPS>("Generating repetition, times = ", times);
+            std::string result;
+            for (int i = 0; i < times; ++i)
+                result += generate(node->children[0], random, tracer);
+            return result;
+        }
+    }
+    return "";
+}
+
+inline std::string generate(const std::shared_ptr<Node>& node, Xoshiro256& random) {
+    Tracer untraced;
+    return generate(node, random, untraced);
+}
+
+// Appends one random word to out. Unlike generate() it neither traces nor
+// builds strings of its own.
+inline void generate_append(const Node& node, Xoshiro256& random, std::string& out) {
+    switch (node.type) {
+        case Node::LITERAL:
+            out += node.value;
+            return;
+        case Node::SEQUENCE:
+            for (const auto& child : node.children) generate_append(*child, random, out);
+            return;
+        case Node::ALTERNATION:
+            generate_append(*node.children[random.uniform(0, static_cast<int>(node.children.size()) - 1)], random, out);
+            return;
+        case Node::REPETITION: {
+            int times = random.uniform(node.repeat_min, node.repeat_max);
+            for (int i = 0; i < times; ++i) generate_append(*node.children[0], random, out);
+            return;
+        }
+    }
+}
+
+// Words are generated in blocks of this many, block b from Xoshiro256(seed, b).
+const size_t GENERATE_BLOCK = 4096;
+
+// Calls sink(std::string_view) with count words. The view is only valid
+// during the call; the word buffer is reused.
+template <typename Sink>
+void generate_n(const std::shared_ptr<Node>& ast, size_t count, Sink&& sink, uint64_t seed = 1) {
+    std::string word;
+    for (size_t block = 0; block * GENERATE_BLOCK < count; ++block) {
+        Xoshiro256 random(seed, block);
+        size_t end = std::min(count, (block + 1) * GENERATE_BLOCK);
+        for (size_t i = block * GENERATE_BLOCK; i < end; ++i) {
+            word.clear();
+            generate_append(*ast, random, word);
+            sink(std::string_view(word));
+        }
+    }
+}
+
+// Writes the words of generate_n, one per line. Blocks are generated in
+// parallel a batch at a time and written in order, so the output depends on
+// the seed only, not on the pool.
+inline void generate_to_stream(const std::shared_ptr<Node>& ast, size_t count, std::ostream& out, uint64_t seed = 1,
+                               ThreadPool& pool = ThreadPool::Default()) {
+    const size_t blocks = (count + GENERATE_BLOCK - 1) / GENERATE_BLOCK;
+    const size_t batch = pool.Size() * 4;
+    std::vector<std::string> buffers(std::min(blocks, batch));
+    for (size_t first = 0; first < blocks; first += batch) {
+        size_t size = std::min(batch, blocks - first);
+        pool.ParallelFor(size, 1, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                size_t block = first + k;
+                Xoshiro256 random(seed, block);
+                std::string& text = buffers[k];
+                text.clear();
+                size_t last = std::min(count, (block + 1) * GENERATE_BLOCK);
+                for (size_t i = block * GENERATE_BLOCK; i < last; ++i) {
+                    generate_append(*ast, random, text);
+                    text += '\n';
+                }
+            }
+        });
+        for (size_t k = 0; k < size; ++k) out.write(buffers[k].data(), static_cast<std::streamsize>(buffers[k].size()));
+        if (!out) throw std::runtime_error("write failed");
+    }
+}
+
+// Builds the Glushkov (position) automaton of a regex: state 0 is the start
+// and every literal occurrence is a state of its own, entered on that
+// literal, so there are no empty moves. A repetition {min, max} is expanded
+// to min copies of its child followed by max - min nested optional copies,
+// x^{0,3} = (x(x(x)?)?)?, which keeps the number of edges linear in max.
+class AutomatonBuilder {
+public:
+    FiniteAutomaton build(const std::shared_ptr<Node>& ast) {
+        symbol_of.fill(FiniteAutomaton::None);
+        Fragment root = compile(ast);
+        for (uint32_t position : root.first) add_follow(0, position);
+
+        std::vector<uint8_t> finals(position_symbol.size(), 0);
+        for (uint32_t position : root.last) finals[position] = 1;
+        finals[0] = root.nullable;
+        return FiniteAutomaton::FromEdges(symbols, position_symbol.size(), std::move(edges), 0, std::move(finals));
+    }
+
+private:
+    // The positions a fragment can start and end with.
+    struct Fragment {
+        bool nullable = true;
+        std::vector<uint32_t> first, last;
+    };
+
+    std::array<FiniteAutomaton::SymbolId, 256> symbol_of;
+    std::vector<std::string> symbols;
+    std::vector<FiniteAutomaton::SymbolId> position_symbol = {FiniteAutomaton::None};
+    std::vector<FiniteAutomaton::Edge> edges;
+
+    void add_follow(uint32_t from, uint32_t to) {
+        edges.push_back({from, position_symbol[to], to});
+    }
+
+    Fragment compile(const std::shared_ptr<Node>& node) {
+        switch (node->type) {
+            case Node::LITERAL: {
+                Fragment fragment;
+                for (char c : node->value) fragment = concat(std::move(fragment), literal(c));
+                return fragment;
+            }
+            case Node::SEQUENCE: {
+                Fragment fragment;
+                for (const auto& child : node->children) fragment = concat(std::move(fragment), compile(child));
+                return fragment;
+            }
+            case Node::ALTERNATION: {
+                Fragment fragment;
+                fragment.nullable = node->children.empty();
+                for (const auto& child : node->children) {
+                    Fragment option = compile(child);
+                    fragment.nullable = fragment.nullable || option.nullable;
+                    fragment.first.insert(fragment.first.end(), option.first.begin(), option.first.end());
+                    fragment.last.insert(fragment.last.end(), option.last.begin(), option.last.end());
+                }
+                return fragment;
+            }
+            case Node::REPETITION: {
+                Fragment optional;
+                for (int i = node->repeat_min; i < node->repeat_max; ++i) {
+                    optional = concat(compile(node->children[0]), optional);
+                    optional.nullable = true;
+                }
+                Fragment required;
+                for (int i = 0; i < node->repeat_min; ++i) required = concat(std::move(required), compile(node->children[0]));
+                return concat(std::move(required), optional);
+            }
+        }
+        return Fragment();
+    }
+
+    Fragment literal(char c) {
+        auto& symbol = symbol_of[static_cast<unsigned char>(c)];
+        if (symbol == FiniteAutomaton::None) {
+            symbol = static_cast<FiniteAutomaton::SymbolId>(symbols.size());
+            symbols.push_back(std::string(1, c));
+        }
+        uint32_t position = static_cast<uint32_t>(position_symbol.size());
+        position_symbol.push_back(symbol);
+
+        Fragment fragment;
+        fragment.nullable = false;
+        fragment.first = fragment.last = {position};
+        return fragment;
+    }
+
+    Fragment concat(Fragment left, const Fragment& right) {
+        for (uint32_t from : left.last)
+            for (uint32_t to : right.first) add_follow(from, to);
+        if (left.nullable) left.first.insert(left.first.end(), right.first.begin(), right.first.end());
+        if (!right.nullable) left.last.clear();
+        left.last.insert(left.last.end(), right.last.begin(), right.last.end());
+        left.nullable = left.nullable && right.nullable;
+        return left;
+    }
+};
+
+inline FiniteAutomaton compile(const std::shared_ptr<Node>& ast) {
+    return AutomatonBuilder().build(ast);
+}
+
+// Matches without unrolling repetitions. As in the Glushkov automaton every
+// literal is one position, but a repetition is compiled once and given a
+// counter instead of being copied max times. A thread of the simulation is a
+// position together with the counters of the repetitions around it, so the
+// automaton grows with the regex and only the threads alive at once depend
+// on the bounds.
+class CountingMatcher {
+public:
+    explicit CountingMatcher(const std::shared_ptr<Node>& ast) {
+        positions.push_back({0, 0, 0});
+        std::vector<uint32_t> chain;
+        Fragment root = compile(ast, chain);
+        for (uint32_t to : root.first) add_follow(0, to, 0, false);
+        start_accepts = root.nullable;
+        for (uint32_t position : root.last) positions[position].final = true;
+
+        std::vector<std::vector<Follow>> sorted(positions.size());
+        for (const auto& [from, follow] : follows) sorted[from].push_back(follow);
+        edge_offsets.push_back(0);
+        for (const auto& out : sorted) {
+            edges.insert(edges.end(), out.begin(), out.end());
+            edge_offsets.push_back(static_cast<uint32_t>(edges.size()));
+        }
+        follows.clear();
+    }
+
+    size_t position_count() const { return positions.size(); }
+
+    bool matches(std::string_view word) const {
+        // Threads are stored back to back as [position, counters...].
+        std::vector<uint32_t> current = {0}, next;
+        ThreadSet seen;
+        for (char c : word) {
+            const auto byte = static_cast<unsigned char>(c);
+            next.clear();
+            seen.clear();
+            for (size_t t = 0; t < current.size(); t += 1 + positions[current[t]].depth) {
+                const Position& from = positions[current[t]];
+                for (uint32_t e = edge_offsets[current[t]]; e < edge_offsets[current[t] + 1]; ++e) {
+                    const Follow& follow = edges[e];
+                    if (follow.byte != byte) continue;
+                    size_t at = next.size();
+                    if (step(from, &current[t + 1], follow, next) && seen.insert(next, at)) continue;
+                    next.resize(at);
+                }
+            }
+            if (next.empty()) return false;
+            current.swap(next);
+        }
+        for (size_t t = 0; t < current.size(); t += 1 + positions[current[t]].depth) {
+            if (current[t] == 0 ? start_accepts : accepts(positions[current[t]], &current[t + 1])) return true;
+        }
+        return false;
+    }
+
+private:
+    struct Repetition {
+        uint32_t min, max;
+        bool nullable_child;
+    };
+
+    // chain_offset indexes the repetitions around the position, outermost
+    // first, in chains.
+    struct Position {
+        unsigned char byte;
+        uint32_t depth;
+        uint32_t chain_offset;
+        bool final = false;
+    };
+
+    // A move into position to. The counters of the keep outermost
+    // repetitions carry over; with iterate the next one starts another
+    // iteration. Every other repetition around the source is left and every
+    // other one around the target is entered.
+    struct Follow {
+        uint32_t to;
+        uint32_t keep;
+        bool iterate;
+        unsigned char byte;
+    };
+
+    struct Fragment {
+        bool nullable = true;
+        std::vector<uint32_t> first, last;
+    };
+
+    std::vector<Repetition> repetitions;
+    std::vector<Position> positions;
+    std::vector<uint32_t> chains;
+    std::vector<std::pair<uint32_t, Follow>> follows;
+    std::vector<uint32_t> edge_offsets;
+    std::vector<Follow> edges;
+    bool start_accepts = false;
+
+    // Distinct threads of one step. The first few are compared one by one;
+    // past that they are found again by hash with linear probing. Threads
+    // are compared from their position on, which fixes their length.
+    class ThreadSet {
+    public:
+        void clear() {
+            if (hashed) std::fill(slots.begin(), slots.end(), Slot{Empty, 0});
+            hashed = false;
+            size = 0;
+        }
+
+        // Whether the thread starting at threads[at] was not there yet.
+        bool insert(const std::vector<uint32_t>& threads, size_t at) {
+            size_t length = threads.size() - at;
+            const uint32_t* thread = &threads[at];
+            if (size < LinearLimit) {
+                for (size_t i = 0; i < size; ++i)
+                    if (std::equal(thread, thread + length, &threads[recent[i]])) return false;
+                recent[size++] = static_cast<uint32_t>(at);
+                return true;
+            }
+            if (!hashed) {
+                for (uint32_t other : recent) place(threads, other, at);
+                hashed = true;
+            }
+            if ((size + 1) * 2 > slots.size()) grow();
+            uint64_t h = hash(thread, length);
+            size_t mask = slots.size() - 1;
+            for (size_t slot = h & mask;; slot = (slot + 1) & mask) {
+                if (slots[slot].at == Empty) {
+                    slots[slot] = {static_cast<uint32_t>(at), h};
+                    ++size;
+                    return true;
+                }
+                if (slots[slot].hash == h && std::equal(thread, thread + length, &threads[slots[slot].at]))
+                    return false;
+            }
+        }
+
+    private:
+        static constexpr uint32_t Empty = UINT32_MAX;
+        static constexpr size_t LinearLimit = 8;
+
+        struct Slot {
+            uint32_t at;
+            uint64_t hash;
+        };
+
+        std::array<uint32_t, LinearLimit> recent;
+        std::vector<Slot> slots = std::vector<Slot>(32, Slot{Empty, 0});
+        size_t size = 0;
+        bool hashed = false;
+
+        static uint64_t hash(const uint32_t* thread, size_t length) {
+            uint64_t h = 0;
+            for (size_t i = 0; i < length; ++i) h = (h ^ thread[i]) * 0x9e3779b97f4a7c15ull;
+            return h ^ (h >> 29);
+        }
+
+        // Hashes one of the first threads, which ends where the next one
+        // (or the one being inserted, at limit) starts.
+        void place(const std::vector<uint32_t>& threads, uint32_t at, size_t limit) {
+            size_t end = limit;
+            for (uint32_t other : recent)
+                if (other > at && other < end) end = other;
+            uint64_t h = hash(&threads[at], end - at);
+            size_t mask = slots.size() - 1;
+            size_t slot = h & mask;
+            while (slots[slot].at != Empty) slot = (slot + 1) & mask;
+            slots[slot] = {at, h};
+        }
+
+        void grow() {
+            std::vector<Slot> old = std::move(slots);
+            slots.assign(old.size() * 2, Slot{Empty, 0});
+            size_t mask = slots.size() - 1;
+            for (const Slot& entry : old) {
+                if (entry.at == Empty) continue;
+                size_t slot = entry.hash & mask;
+                while (slots[slot].at != Empty) slot = (slot + 1) & mask;
+                slots[slot] = entry;
+            }
+        }
+    };
+
+    const Repetition& repetition(const Position& position, uint32_t level) const {
+        return repetitions[chains[position.chain_offset + level]];
+    }
+
+    bool can_leave(const Position& position, const uint32_t* counters, uint32_t level) const {
+        const Repetition& r = repetition(position, level);
+        return r.nullable_child || counters[level] >= r.min;
+    }
+
+    bool accepts(const Position& position, const uint32_t* counters) const {
+        if (!position.final) return false;
+        for (uint32_t level = 0; level < position.depth; ++level)
+            if (!can_leave(position, counters, level)) return false;
+        return true;
+    }
+
+    // Appends the thread follow leads to, if its counters allow the move.
+    bool step(const Position& from, const uint32_t* counters, const Follow& follow, std::vector<uint32_t>& out) const {
+        const Position& to = positions[follow.to];
+        uint32_t fresh = follow.keep;
+        if (follow.iterate) {
+            if (counters[fresh] >= repetition(to, fresh).max) return false;
+            ++fresh;
+        }
+        for (uint32_t level = fresh; level < from.depth; ++level)
+            if (!can_leave(from, counters, level)) return false;
+
+        out.push_back(follow.to);
+        out.insert(out.end(), counters, counters + follow.keep);
+        if (follow.iterate) out.push_back(counters[follow.keep] + 1);
+        out.resize(out.size() + (to.depth - fresh), 1);
+        return true;
+    }
+
+    void add_follow(uint32_t from, uint32_t to, uint32_t keep, bool iterate) {
+        follows.push_back({from, {to, keep, iterate, positions[to].byte}});
+    }
+
+    Fragment compile(const std::shared_ptr<Node>& node, std::vector<uint32_t>& chain) {
+        switch (node->type) {
+            case Node::LITERAL: {
+                Fragment fragment;
+                for (char c : node->value) {
+                    Fragment one;
+                    one.nullable = false;
+                    one.first = one.last = {static_cast<uint32_t>(positions.size())};
+                    positions.push_back({static_cast<unsigned char>(c), static_cast<uint32_t>(chain.size()),
+                                         static_cast<uint32_t>(chains.size())});
+                    chains.insert(chains.end(), chain.begin(), chain.end());
+                    fragment = concat(std::move(fragment), one, chain);
+                }
+                return fragment;
+            }
+            case Node::SEQUENCE: {
+                Fragment fragment;
+                for (const auto& child : node->children) fragment = concat(std::move(fragment), compile(child, chain), chain);
+                return fragment;
+            }
+            case Node::ALTERNATION: {
+                Fragment fragment;
+                fragment.nullable = node->children.empty();
+                for (const auto& child : node->children) {
+                    Fragment option = compile(child, chain);
+                    fragment.nullable = fragment.nullable || option.nullable;
+                    fragment.first.insert(fragment.first.end(), option.first.begin(), option.first.end());
+                    fragment.last.insert(fragment.last.end(), option.last.begin(), option.last.end());
+                }
+                return fragment;
+            }
+            case Node::REPETITION: {
+                if (node->repeat_max <= 0) return Fragment();
+                auto level = static_cast<uint32_t>(chain.size());
+                chain.push_back(static_cast<uint32_t>(repetitions.size()));
+                repetitions.push_back({static_cast<uint32_t>(std::max(node->repeat_min, 0)),
+                                       static_cast<uint32_t>(node->repeat_max), false});
+                auto id = chain.back();
+                Fragment fragment = compile(node->children[0], chain);
+                chain.pop_back();
+
+                repetitions[id].nullable_child = fragment.nullable;
+                if (node->repeat_max > 1) {
+                    for (uint32_t from : fragment.last)
+                        for (uint32_t to : fragment.first) add_follow(from, to, level, true);
+                }
+                fragment.nullable = fragment.nullable || node->repeat_min <= 0;
+                return fragment;
+            }
+        }
+        return Fragment();
+    }
+
+    Fragment concat(Fragment left, const Fragment& right, const std::vector<uint32_t>& chain) {
+        auto keep = static_cast<uint32_t>(chain.size());
+        for (uint32_t from : left.last)
+            for (uint32_t to : right.first) add_follow(from, to, keep, false);
+        if (left.nullable) left.first.insert(left.first.end(), right.first.begin(), right.first.end());
+        if (!right.nullable) left.last.clear();
+        left.last.insert(left.last.end(), right.last.begin(), right.last.end());
+        left.nullable = left.nullable && right.nullable;
+        return left;
+    }
+};
+
+// The number of positions the regex has once its repetitions are unrolled,
+// capped at limit + 1.
+inline size_t unrolled_size(const std::shared_ptr<Node>& node, size_t limit) {
+    size_t size = 0;
+    switch (node->type) {
+        case Node::LITERAL:
+            size = node->value.size();
+            break;
+        case Node::SEQUENCE:
+        case Node::ALTERNATION:
+            for (const auto& child : node->children) size += unrolled_size(child, limit);
+            break;
+        case Node::REPETITION: {
+            size_t child = unrolled_size(node->children[0], limit);
+            size_t times = static_cast<size_t>(std::max(node->repeat_max, 0));
+            size = child != 0 && times > limit / child ? limit + 1 : child * times;
+            break;
+        }
+    }
+    return std::min(size, limit + 1);
+}
+
+// The memory the subset construction may use before a regex is matched
+// without a DFA.
+constexpr size_t DfaMemoryBudget = size_t(64) << 20;
+
+// A regex compiled for matching whole strings: to a minimal DFA when its
+// unrolled form is small enough and its subset construction fits in
+// DfaMemoryBudget, to a CountingMatcher otherwise.
+class Matcher {
+    static constexpr size_t UnrollLimit = 1 << 14;
+
+    std::optional<CompiledAutomaton> compiled;
+    std::optional<CountingMatcher> counting;
+    size_t states = 0;
+
+public:
+    explicit Matcher(const std::shared_ptr<Node>& ast) {
+        if (unrolled_size(ast, UnrollLimit) > UnrollLimit) {
+            counting.emplace(ast);
+            states = counting->position_count();
+            return;
+        }
+        try {
+            FiniteAutomaton dfa = compile(ast).Minimize(DfaMemoryBudget);
+            states = dfa.StateCount();
+            compiled.emplace(dfa);
+        } catch (const std::length_error&) {
+            counting.emplace(ast);
+            states = counting->position_count();
+        }
+    }
+    explicit Matcher(const std::string& regex) : Matcher(Parser(regex).parse()) {}
+
+    bool matches(std::string_view word) const { return compiled ? compiled->Accepts(word) : counting->matches(word); }
+    bool uses_counters() const { return counting.has_value(); }
+    // DFA states, or CountingMatcher positions.
+    size_t state_count() const { return states; }
+
+    LineCounts count_file(const std::string& path) const {
+        if (compiled) return compiled->CountFile(path);
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        LineCounts counts;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            (matches(line) ? counts.accepted : counts.rejected)++;
+        }
+        return counts;
+    }
+};
+
+#endif
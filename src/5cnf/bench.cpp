@@ -0,0 +1,303 @@
+// Benchmarks for the CNF converter and the CYK and Valiant recognizers. Build and run
+// from this directory:
+//   g++ -std=c++17 -O2 -pthread -o bench bench.cpp
+//   ./bench [random|chain|nullable] [productions]
+//   ./bench cyk [words]
+//   ./bench valiant [max length]
+#include "cnf.hpp"
+#include "cyk.hpp"
+#include "valiant.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A grammar with about the given number of productions over nonterminals
+// N0, N1, ... and terminals a..z: one in 100 productions is empty and one
+// in 50 is a unit production, the rest have two to six symbols. Denser unit
+// or empty productions make the unit closure, and so the output, quadratic
+// in the number of nonterminals.
+CNFConverter::Grammar randomGrammar(size_t productions, uint32_t seed) {
+    std::mt19937 rng(seed);
+    size_t nonTerminals = std::max<size_t>(1, productions / 8);
+    auto nonTerminal = [&] { return "N" + std::to_string(rng() % nonTerminals); };
+    auto terminal = [&] { return std::string(1, static_cast<char>('a' + rng() % 26)); };
+
+    CNFConverter::Grammar grammar;
+    for (size_t i = 0; i < productions; ++i) {
+        // Every nonterminal gets a production before any gets a second.
+        std::string head = i < nonTerminals ? "N" + std::to_string(i) : nonTerminal();
+        CNFConverter::Production prod;
+        uint32_t kind = rng() % 100;
+        if (kind == 0) {
+            prod = {"~"};
+        } else if (kind < 3) {
+            prod = {nonTerminal()};
+        } else {
+            size_t length = 2 + rng() % 5;
+            for (size_t k = 0; k < length; ++k) prod.push_back(rng() % 3 ? nonTerminal() : terminal());
+        }
+        grammar[head].push_back(std::move(prod));
+    }
+    return grammar;
+}
+
+// N0 -> a N1 | b N1 N1, ..., N(n-1) -> a: each nonterminal only becomes
+// generating after the next one, the worst case for a fixpoint that
+// rescans the grammar until nothing changes.
+CNFConverter::Grammar chainGrammar(size_t productions) {
+    size_t length = std::max<size_t>(1, productions / 2);
+    CNFConverter::Grammar grammar;
+    for (size_t i = 0; i + 1 < length; ++i) {
+        std::string next = "N" + std::to_string(i + 1);
+        grammar["N" + std::to_string(i)] = {{"a", next}, {"b", next, next}};
+    }
+    grammar["N" + std::to_string(length - 1)] = {{"a"}};
+    return grammar;
+}
+
+// Rules N(i) -> a E E ... E of one terminal and eleven nullable
+// nonterminals (E(j) -> ~ | e). Removing empty productions first gives every
+// rule 2^11 expansions; splitting long rules first gives a few per rule.
+CNFConverter::Grammar nullableGrammar(size_t productions, uint32_t seed) {
+    std::mt19937 rng(seed);
+    size_t nonTerminals = std::max<size_t>(1, productions / 8);
+    CNFConverter::Grammar grammar;
+    for (size_t i = 0; i < nonTerminals; ++i) grammar["E" + std::to_string(i)] = {{"~"}, {"e"}};
+    for (size_t i = 2 * nonTerminals; i < productions; ++i) {
+        CNFConverter::Production prod = {"a"};
+        for (size_t k = 0; k < 11; ++k) prod.push_back("E" + std::to_string(rng() % nonTerminals));
+        std::swap(prod[0], prod[rng() % prod.size()]);
+        grammar["N" + std::to_string(rng() % nonTerminals)].push_back(std::move(prod));
+    }
+    return grammar;
+}
+
+size_t countProductions(const CNFConverter::Grammar& grammar) {
+    size_t count = 0;
+    for (const auto& [A, prods] : grammar) count += prods.size();
+    return count;
+}
+
+// Binary operators at the given number of precedence levels over atoms x
+// and n with parentheses: E0 -> E0 + E1 | E1, E1 -> E1 - E2 | E2, ...,
+// E(levels) -> ( E0 ) | x | n, cycling through ten operator characters.
+CNFConverter::Grammar expressionGrammar(size_t levels) {
+    const std::string operators = "+-*/%^&|<>";
+    CNFConverter::Grammar grammar;
+    for (size_t i = 0; i < levels; ++i) {
+        std::string level = "E" + std::to_string(i), next = "E" + std::to_string(i + 1);
+        grammar[level] = {{level, std::string(1, operators[i % operators.size()]), next}, {next}};
+    }
+    grammar["E" + std::to_string(levels)] = {{"(", "E0", ")"}, {"x"}, {"n"}};
+    return grammar;
+}
+
+// An expression of about the given length: atoms joined by operators,
+// some of them parenthesized subexpressions.
+std::string randomExpression(size_t length, std::mt19937& rng) {
+    const std::string operators = "+-*/%^&|<>";
+    std::string word;
+    while (true) {
+        size_t left = length > word.size() ? length - word.size() : 0;
+        if (left > 8 && rng() % 6 == 0) {
+            word += '(' + randomExpression(1 + rng() % std::min<size_t>(40, left - 2), rng) + ')';
+        } else {
+            word += rng() % 2 ? 'x' : 'n';
+        }
+        if (word.size() + 2 > length) return word;
+        word += operators[rng() % operators.size()];
+    }
+}
+
+template <typename F>
+double secondsFor(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int benchConvert(const std::string& mode, size_t productions) {
+    for (uint32_t seed = 1; seed <= 3; ++seed) {
+        CNFConverter::Grammar grammar = mode == "chain"      ? chainGrammar(productions)
+                                        : mode == "nullable" ? nullableGrammar(productions, seed)
+                                                             : randomGrammar(productions, seed);
+        std::cout << mode << " " << seed << ": " << countProductions(grammar) << " productions\n";
+        for (auto order : {CNFConverter::Order::DelFirst, CNFConverter::Order::BinFirst}) {
+            CNFConverter::Grammar cnf;
+            double seconds = secondsFor([&] { cnf = CNFConverter(grammar, "N0").convertToCNF(order); });
+            std::cout << (order == CNFConverter::Order::DelFirst ? "  del first: " : "  bin first: ")
+                      << countProductions(cnf) << " in CNF, " << seconds * 1000 << " ms\n";
+        }
+    }
+    return 0;
+}
+
+// Expressions of 500 tokens, half of them with one character changed,
+// against the CNF of expressionGrammar: one word at a time, one word with
+// the diagonals on the pool, and the batch API.
+int benchCyk(size_t words) {
+    const size_t length = 500;
+    for (size_t levels : {size_t(10), size_t(40), size_t(120)}) {
+        CNFConverter::Grammar cnf = CNFConverter(expressionGrammar(levels), "E0").convertToCNF();
+        CYKParser parser(cnf, "E0");
+        std::cout << "cyk: " << levels << " levels, " << parser.nonTerminalCount() << " nonterminals, "
+                  << countProductions(cnf) << " rules, " << words << " words of length " << length << "\n";
+
+        std::mt19937 rng(1);
+        std::vector<std::string> batch;
+        for (size_t i = 0; i < words; ++i) {
+            std::string word = randomExpression(length, rng);
+            if (i % 2) word[rng() % word.size()] = "x+()"[rng() % 4];
+            batch.push_back(std::move(word));
+        }
+
+        std::vector<uint8_t> expected;
+        double seconds = secondsFor([&] {
+            for (const auto& word : batch) expected.push_back(parser.recognize(word));
+        });
+        std::cout << "  recognize: " << words / seconds << " words/s ("
+                  << std::count(expected.begin(), expected.end(), 1) << " accepted)\n";
+
+        // At least two threads, so that the diagonals are filled in parallel.
+        ThreadPool pool(std::max<size_t>(2, ThreadPool::Default().Size()));
+        std::vector<uint8_t> actual;
+        seconds = secondsFor([&] {
+            for (const auto& word : batch) actual.push_back(parser.recognize(word, pool));
+        });
+        std::cout << "  recognize on " << pool.Size() << " threads: " << words / seconds << " words/s"
+                  << (actual == expected ? "\n" : " (MISMATCH)\n");
+
+        std::vector<uint8_t> result;
+        seconds = secondsFor([&] { result = parser.recognizeAll(batch); });
+        std::cout << "  recognizeAll on " << ThreadPool::Default().Size() << " thread(s): " << words / seconds
+                  << " words/s\n";
+    }
+
+    // A converted grammar far past DenseLimit, on the sparse pair tables.
+    CNFConverter::Grammar cnf = CNFConverter(randomGrammar(20000, 1), "N0").convertToCNF(CNFConverter::Order::BinFirst);
+    std::unique_ptr<CYKParser> parser;
+    double seconds = secondsFor([&] { parser = std::make_unique<CYKParser>(cnf, "N0"); });
+    std::cout << "cyk: random grammar, " << parser->nonTerminalCount() << " nonterminals, " << countProductions(cnf)
+              << " rules, built in " << seconds * 1000 << " ms\n";
+    std::mt19937 rng(1);
+    std::vector<std::string> batch(200);
+    for (auto& word : batch) {
+        for (size_t i = 0; i < 40; ++i) word += static_cast<char>('a' + rng() % 26);
+    }
+    size_t accepted = 0;
+    seconds = secondsFor([&] {
+        for (const auto& word : batch) accepted += parser->recognize(word);
+    });
+    std::cout << "  recognize: " << batch.size() / seconds << " words/s of length 40 (" << accepted
+              << " accepted)\n";
+    return 0;
+}
+
+// A balanced word of parentheses of the given even length.
+std::string randomDyck(size_t length, std::mt19937& rng) {
+    std::string word;
+    size_t open = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (open > 0 && (open == length - i || rng() % 2)) {
+            word += ')';
+            --open;
+        } else {
+            word += '(';
+            ++open;
+        }
+    }
+    return word;
+}
+
+// CYKParser against ValiantRecognizer on one word per length, doubling the
+// length up to the given maximum: S -> S S | S b S | a on mostly a's, where
+// almost every span derives S and CYK does all n^3 / 6 splits; balanced
+// parentheses; and the ten-level expression grammar. Lengths are one below
+// a power of two, since the recognizer rounds n + 1 up to one. CYK stops
+// once one word takes more than 20 s.
+int benchValiant(size_t maxLength) {
+    struct Case {
+        const char* name;
+        CNFConverter::Grammar grammar;
+        std::string start;
+    };
+    std::vector<Case> cases = {
+        {"S -> S S | S b S | a", {{"S", {{"S", "S"}, {"S", "b", "S"}, {"a"}}}}, "S"},
+        {"dyck", {{"S", {{"S", "S"}, {"(", "S", ")"}, {"(", ")"}}}}, "S"},
+        {"expression, 10 levels", expressionGrammar(10), "E0"},
+    };
+    for (const auto& test : cases) {
+        CNFConverter::Grammar cnf = CNFConverter(test.grammar, test.start).convertToCNF();
+        CYKParser parser(cnf, test.start);
+        ValiantRecognizer valiant(cnf, test.start);
+        std::cout << "valiant: " << test.name << ", " << valiant.nonTerminalCount() << " nonterminals, "
+                  << ThreadPool::Default().Size() << " thread(s)\n";
+        std::mt19937 rng(1);
+        bool cykDone = false;
+        for (size_t length = 255; length <= maxLength; length = 2 * length + 1) {
+            std::string word;
+            if (test.start == "E0") {
+                word = randomExpression(length, rng);
+            } else if (test.name[0] == 'd') {
+                word = randomDyck(length - 1, rng);
+            } else {
+                for (size_t i = 0; i < length; ++i) {
+                    bool b = i > 0 && i + 1 < length && word.back() == 'a' && rng() % 8 == 0;
+                    word += b ? 'b' : 'a';
+                }
+            }
+            bool accepted = false;
+            double seconds = secondsFor([&] { accepted = valiant.recognize(word); });
+            std::cout << "  " << word.size() << " tokens: valiant " << seconds * 1000 << " ms";
+            if (!cykDone) {
+                bool expected = false;
+                double cykSeconds = secondsFor([&] { expected = parser.recognize(word); });
+                std::cout << ", cyk " << cykSeconds * 1000 << " ms" << (expected == accepted ? "" : " (MISMATCH)");
+                cykDone = cykSeconds > 20;
+            }
+            std::cout << (accepted ? ", accepted\n" : ", rejected\n");
+        }
+    }
+
+    // A converted grammar with tens of thousands of nonterminals, on short words.
+    CNFConverter::Grammar cnf = CNFConverter(randomGrammar(20000, 1), "N0").convertToCNF(CNFConverter::Order::BinFirst);
+    CYKParser parser(cnf, "N0");
+    std::unique_ptr<ValiantRecognizer> valiant;
+    double seconds = secondsFor([&] { valiant = std::make_unique<ValiantRecognizer>(cnf, "N0"); });
+    std::cout << "valiant: random grammar, " << valiant->nonTerminalCount() << " nonterminals, built in "
+              << seconds * 1000 << " ms\n";
+    std::mt19937 rng(1);
+    size_t agreed = 0, words = 50;
+    seconds = secondsFor([&] {
+        for (size_t i = 0; i < words; ++i) {
+            std::string word;
+            for (size_t k = 0; k < 40; ++k) word += static_cast<char>('a' + rng() % 26);
+            agreed += valiant->recognize(word) == parser.recognize(word);
+        }
+    });
+    std::cout << "  " << words << " words of length 40 in " << seconds * 1000 << " ms"
+              << (agreed == words ? "\n" : " (MISMATCH)\n");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "random";
+    size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    if (mode == "random" || mode == "chain") return benchConvert(mode, count ? count : 20000);
+    if (mode == "nullable") return benchConvert(mode, count ? count : 1000);
+    if (mode == "cyk") return benchCyk(count ? count : 2000);
+    if (mode == "valiant") return benchValiant(count ? count : 4095);
+    std::cerr << "usage: bench [random|chain|nullable] [productions]\n"
+                 "       bench cyk [words]\n"
+                 "       bench valiant [max length]\n";
+    return 2;
+}
@@ -0,0 +1,372 @@
+#ifndef CNF_H
+#define CNF_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Converts a context-free grammar to Chomsky normal form. Symbols are
+// interned as ids with a terminal flag (a nonterminal starts with an upper
+// case letter, "~" is the empty word) and every production is a span of one
+// uint32_t pool, so the passes compare integers and rewrite the rule list and
+// the pool in place instead of building new maps of strings.
+//
+// The classic order removes empty productions first, which gives a rule
+// with k nullable symbols 2^k expansions. BinFirst splits long rules first,
+// as Lange and Leiss suggest; every rule then has at most two symbols and
+// at most four expansions, so the output stays polynomial in the input.
+class CNFConverter {
+public:
+    using Symbol = std::string;
+    using Production = std::vector<Symbol>;
+    using Grammar = std::unordered_map<Symbol, std::vector<Production>>;
+
+    enum class Order { DelFirst, BinFirst };
+
+    CNFConverter(const Grammar& input, const Symbol& start)
+        : startSymbol(intern(start)), epsilon(intern("~")), newVarCount(0) {
+        for (const auto& [A, prods] : input) {
+            uint32_t head = intern(A);
+            for (const auto& prod : prods) {
+                Rule rule{head, static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(prod.size())};
+                for (const auto& symbol : prod) pool.push_back(intern(symbol));
+                rules.push_back(rule);
+            }
+        }
+    }
+
+    Grammar convertToCNF(Order order = Order::DelFirst) {
+        if (order == Order::BinFirst) convertLongProductions();
+        removeNullProductions();
+        removeDuplicateRules();
+        removeUnitProductions();
+        removeDuplicateRules();
+        removeUselessSymbols();
+        convertTerminalsInRules();
+        if (order == Order::DelFirst) convertLongProductions();
+        return toGrammar();
+    }
+
+private:
+    // The body of a rule is pool[first] .. pool[first + size - 1].
+    struct Rule {
+        uint32_t head;
+        uint32_t first;
+        uint32_t size;
+    };
+
+    std::vector<Symbol> names;
+    std::vector<uint8_t> terminal;
+    std::unordered_map<Symbol, uint32_t> ids;
+    std::vector<Rule> rules;
+    std::vector<uint32_t> pool;
+    uint32_t startSymbol;
+    uint32_t epsilon;
+    int newVarCount;
+
+    uint32_t intern(const Symbol& name) {
+        auto [it, added] = ids.emplace(name, static_cast<uint32_t>(names.size()));
+        if (added) {
+            names.push_back(name);
+            terminal.push_back(!isNonTerminal(name));
+        }
+        return it->second;
+    }
+
+    uint32_t getNewVariable() {
+        return intern("X" + std::to_string(++newVarCount));
+    }
+
+    const uint32_t* body(const Rule& rule) const { return pool.data() + rule.first; }
+
+    bool isUnit(const Rule& rule) const { return rule.size == 1 && !terminal[pool[rule.first]]; }
+
+    // symbols must not point into the pool, which may move as it grows.
+    void addRule(uint32_t head, const uint32_t* symbols, uint32_t size) {
+        rules.push_back({head, static_cast<uint32_t>(pool.size()), size});
+        pool.insert(pool.end(), symbols, symbols + size);
+    }
+
+    // A new rule for head with the body of an existing one.
+    void copyRule(uint32_t head, Rule rule) {
+        rules.push_back({head, static_cast<uint32_t>(pool.size()), rule.size});
+        for (uint32_t i = 0; i < rule.size; ++i) pool.push_back(pool[rule.first + i]);
+    }
+
+    // Drops the pool entries no rule refers to any more. Rules stay in
+    // order of their spans, so every span moves down in place.
+    void compactPool() {
+        uint32_t used = 0;
+        for (auto& rule : rules) {
+            std::copy(pool.begin() + rule.first, pool.begin() + rule.first + rule.size, pool.begin() + used);
+            rule.first = used;
+            used += rule.size;
+        }
+        pool.resize(used);
+    }
+
+    // Keeps the rules for which keep(rule) holds, called once per rule in
+    // order; the pool is compacted only afterwards, so keep may still read
+    // the spans of rules it has already seen.
+    template <typename Keep>
+    void keepRules(Keep&& keep) {
+        size_t kept = 0;
+        for (const Rule& rule : rules) {
+            if (keep(rule)) rules[kept++] = rule;
+        }
+        rules.resize(kept);
+        compactPool();
+    }
+
+    struct RuleHash {
+        const CNFConverter* converter;
+        size_t operator()(const Rule& rule) const {
+            uint64_t hash = 0x9e3779b97f4a7c15ull * (rule.head + 1);
+            for (uint32_t i = 0; i < rule.size; ++i) {
+                hash = (hash ^ converter->pool[rule.first + i]) * 0x100000001b3ull;
+            }
+            return static_cast<size_t>(hash ^ (hash >> 29));
+        }
+    };
+
+    struct RuleEqual {
+        const CNFConverter* converter;
+        bool operator()(const Rule& a, const Rule& b) const {
+            return a.head == b.head && a.size == b.size &&
+                   std::equal(converter->body(a), converter->body(a) + a.size, converter->body(b));
+        }
+    };
+
+    // Null expansion and unit copies repeat bodies a head already has.
+    void removeDuplicateRules() {
+        std::unordered_set<Rule, RuleHash, RuleEqual> seen(rules.size(), RuleHash{this}, RuleEqual{this});
+        keepRules([&](const Rule& rule) { return seen.insert(rule).second; });
+    }
+
+    // Rule indices grouped by a key: the rules of key k are
+    // items[offsets[k]] .. items[offsets[k + 1] - 1].
+    struct RuleIndex {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> items;
+    };
+
+    // Groups the rules by head, or with bySymbol by every symbol of their
+    // bodies, once per occurrence. A counting sort, linear in the grammar.
+    RuleIndex indexRules(bool bySymbol) const {
+        RuleIndex index;
+        index.offsets.assign(names.size() + 1, 0);
+        for (const auto& rule : rules) {
+            if (!bySymbol) index.offsets[rule.head + 1]++;
+            else for (uint32_t i = 0; i < rule.size; ++i) index.offsets[pool[rule.first + i] + 1]++;
+        }
+        for (size_t k = 0; k < names.size(); ++k) index.offsets[k + 1] += index.offsets[k];
+        index.items.resize(index.offsets.back());
+        std::vector<uint32_t> fill(index.offsets.begin(), index.offsets.end() - 1);
+        for (uint32_t r = 0; r < rules.size(); ++r) {
+            const Rule& rule = rules[r];
+            if (!bySymbol) index.items[fill[rule.head]++] = r;
+            else for (uint32_t i = 0; i < rule.size; ++i) index.items[fill[pool[rule.first + i]]++] = r;
+        }
+        return index;
+    }
+
+    // Marks the heads of rules whose every body symbol is marked, starting
+    // from the symbols already marked. Each rule keeps a count of its
+    // unmarked symbols; a newly marked symbol decrements the rules it
+    // occurs in, so every occurrence is visited once.
+    void markClosure(std::vector<uint8_t>& marked) const {
+        RuleIndex occurrences = indexRules(true);
+        std::vector<uint32_t> missing(rules.size());
+        for (uint32_t r = 0; r < rules.size(); ++r) {
+            const Rule& rule = rules[r];
+            missing[r] = static_cast<uint32_t>(
+                std::count_if(body(rule), body(rule) + rule.size, [&](uint32_t s) { return !marked[s]; }));
+        }
+
+        std::vector<uint32_t> worklist;
+        auto mark = [&](uint32_t r) {
+            if (missing[r] == 0 && !marked[rules[r].head]) {
+                marked[rules[r].head] = 1;
+                worklist.push_back(rules[r].head);
+            }
+        };
+        for (uint32_t r = 0; r < rules.size(); ++r) mark(r);
+        for (size_t next = 0; next < worklist.size(); ++next) {
+            uint32_t s = worklist[next];
+            for (uint32_t i = occurrences.offsets[s]; i < occurrences.offsets[s + 1]; ++i) {
+                --missing[occurrences.items[i]];
+                mark(occurrences.items[i]);
+            }
+        }
+    }
+
+    void removeNullProductions() {
+        std::vector<uint8_t> nullable(names.size(), 0);
+
+        for (const auto& rule : rules) {
+            if (rule.size == 1 && pool[rule.first] == epsilon) {
+                nullable[rule.head] = 1;
+            }
+        }
+        markClosure(nullable);
+
+        // Every rule is replaced by its expansions, written after the
+        // existing rules: each subset of its nullable symbols may be left out.
+        const size_t original = rules.size();
+        std::vector<uint32_t> optional;
+        std::vector<uint32_t> expansion;
+        for (size_t r = 0; r < original; ++r) {
+            Rule rule = rules[r];
+            optional.clear();
+            for (uint32_t i = 0; i < rule.size; ++i) {
+                if (nullable[pool[rule.first + i]]) optional.push_back(i);
+            }
+            if (optional.size() >= 32) throw std::length_error("too many nullable symbols in one production");
+            for (uint64_t dropped = 0; dropped < (uint64_t(1) << optional.size()); ++dropped) {
+                expansion.clear();
+                for (uint32_t i = 0, k = 0; i < rule.size; ++i) {
+                    bool drop = k < optional.size() && optional[k] == i && ((dropped >> k++) & 1);
+                    if (!drop) expansion.push_back(pool[rule.first + i]);
+                }
+                if (!expansion.empty() && !(expansion.size() == 1 && expansion[0] == epsilon)) {
+                    addRule(rule.head, expansion.data(), static_cast<uint32_t>(expansion.size()));
+                }
+            }
+        }
+        rules.erase(rules.begin(), rules.begin() + original);
+        compactPool();
+    }
+
+    // For every nonterminal A, walks the unit rules A -> B -> C ... and
+    // gives A a copy of the non-unit rules of everything it reaches.
+    void removeUnitProductions() {
+        // Rules by head, as they are before any are copied.
+        RuleIndex byHead = indexRules(false);
+        std::vector<uint32_t> seenFrom(names.size(), UINT32_MAX);
+        std::vector<uint32_t> worklist;
+
+        for (uint32_t A = 0; A < names.size(); ++A) {
+            worklist.assign(1, A);
+            seenFrom[A] = A;
+            for (size_t next = 0; next < worklist.size(); ++next) {
+                uint32_t B = worklist[next];
+                for (uint32_t i = byHead.offsets[B]; i < byHead.offsets[B + 1]; ++i) {
+                    Rule rule = rules[byHead.items[i]];
+                    if (!isUnit(rule)) {
+                        if (B != A) copyRule(A, rule);
+                    } else if (seenFrom[pool[rule.first]] != A) {
+                        seenFrom[pool[rule.first]] = A;
+                        worklist.push_back(pool[rule.first]);
+                    }
+                }
+            }
+        }
+
+        keepRules([&](const Rule& rule) { return !isUnit(rule); });
+    }
+
+    void removeUselessSymbols() {
+        std::vector<uint8_t> generating(terminal.begin(), terminal.end());
+        markClosure(generating);
+
+        std::vector<uint8_t> reachable(names.size(), 0);
+        RuleIndex byHead = indexRules(false);
+        std::vector<uint32_t> worklist = {startSymbol};
+        reachable[startSymbol] = 1;
+        for (size_t next = 0; next < worklist.size(); ++next) {
+            uint32_t A = worklist[next];
+            for (uint32_t i = byHead.offsets[A]; i < byHead.offsets[A + 1]; ++i) {
+                const Rule& rule = rules[byHead.items[i]];
+                for (uint32_t j = 0; j < rule.size; ++j) {
+                    uint32_t s = pool[rule.first + j];
+                    if (!terminal[s] && !reachable[s]) {
+                        reachable[s] = 1;
+                        worklist.push_back(s);
+                    }
+                }
+            }
+        }
+
+        auto useful = [&](uint32_t s) { return terminal[s] || (generating[s] && reachable[s]); };
+        keepRules([&](const Rule& rule) {
+            return useful(rule.head) && std::all_of(body(rule), body(rule) + rule.size, useful);
+        });
+    }
+
+    // Terminals in rules of two or more symbols are replaced in place by a
+    // new variable that derives just that terminal.
+    void convertTerminalsInRules() {
+        std::unordered_map<uint32_t, uint32_t> termToVar;
+        const size_t original = rules.size();
+
+        for (size_t r = 0; r < original; ++r) {
+            const Rule rule = rules[r];
+            if (rule.size == 1 && terminal[pool[rule.first]]) continue;
+
+            for (uint32_t i = 0; i < rule.size; ++i) {
+                uint32_t s = pool[rule.first + i];
+                if (!terminal[s]) continue;
+                auto found = termToVar.find(s);
+                if (found == termToVar.end()) {
+                    uint32_t newVar = getNewVariable();
+                    found = termToVar.emplace(s, newVar).first;
+                    addRule(newVar, &s, 1);
+                }
+                pool[rule.first + i] = found->second;
+            }
+        }
+    }
+
+    // Rules longer than two symbols are folded from the right, sharing one
+    // new variable per pair: A -> B C D becomes A -> B X1, X1 -> C D. The
+    // rule's own span is cut down to its last two symbols in place.
+    void convertLongProductions() {
+        std::unordered_map<uint64_t, uint32_t> pairToVar;
+        const size_t original = rules.size();
+
+        for (size_t r = 0; r < original; ++r) {
+            const Rule rule = rules[r];
+            if (rule.size <= 2) continue;
+
+            uint32_t last = rule.first + rule.size;
+            uint32_t right = pool[--last];
+            while (last > rule.first + 1) {
+                uint32_t left = pool[--last];
+                uint64_t key = (uint64_t(left) << 32) | right;
+                auto found = pairToVar.find(key);
+                if (found == pairToVar.end()) {
+                    uint32_t temp = getNewVariable();
+                    found = pairToVar.emplace(key, temp).first;
+                    uint32_t pair[2] = {left, right};
+                    addRule(temp, pair, 2);
+                }
+                right = found->second;
+            }
+            pool[rule.first + 1] = right;
+            rules[r].size = 2;
+        }
+        compactPool();
+    }
+
+    Grammar toGrammar() const {
+        Grammar grammar;
+        for (const auto& rule : rules) {
+            Production prod;
+            for (uint32_t i = 0; i < rule.size; ++i) prod.push_back(names[pool[rule.first + i]]);
+            grammar[names[rule.head]].push_back(std::move(prod));
+        }
+        return grammar;
+    }
+
+    static bool isNonTerminal(const Symbol& s) {
+        return !s.empty() && std::isupper(static_cast<unsigned char>(s[0]));
+    }
+};
+
+#endif
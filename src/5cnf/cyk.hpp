@@ -0,0 +1,657 @@
+#ifndef CYK_H
+#define CYK_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "cnf.hpp"
+#include "../2DFA/ThreadPool.hpp"
+
+// A derivation of a word: the nonterminal at the root and either two
+// subtrees or, for A -> a, one leaf holding the terminal.
+struct ParseTree {
+    std::string symbol;
+    std::vector<ParseTree> children;
+};
+
+// CYK membership and parsing for a grammar in Chomsky normal form, as
+// CNFConverter produces it. A chart cell is a bitset over nonterminals, and
+// every pair (B, C) that is the body of some rule has a precomputed mask of
+// the heads A with A -> B C, so combining two cells is word-level AND and
+// OR. Bitsets of the non-empty cells by start and end point give the splits
+// of a span without looking at empty cells. Those per-pair tables are
+// dense in the number of nonterminals, so grammars with more than
+// DenseLimit of them use sorted partner lists and head lists instead.
+//
+// One thread fills the chart row by row and caches the result of each pair
+// of cell contents it combines; with a pool, the cells of each span length
+// are filled in parallel instead, each thread with its own cache of pairs.
+// A diagonal at a time leaves little work per task, so recognizeAll, one
+// word per task, is the path for throughput; recognize with a pool only
+// shortens the wait for one long word.
+//
+// Words are sequences of terminals: a std::string is read one character per
+// terminal, a vector of symbols one symbol per terminal. The converter
+// drops the empty word, so it is never accepted.
+class CYKParser {
+public:
+    CYKParser(const CNFConverter::Grammar& grammar, const CNFConverter::Symbol& start) {
+        for (const auto& [A, prods] : grammar) {
+            internNonTerminal(A);
+            for (const auto& prod : prods) {
+                if (prod.size() == 2) {
+                    internNonTerminal(prod[0]);
+                    internNonTerminal(prod[1]);
+                } else if (prod.size() != 1) {
+                    throw std::invalid_argument("grammar is not in Chomsky normal form");
+                }
+            }
+        }
+        pairStride = nonTerminals.size();
+        words = (pairStride + 63) / 64;
+        auto found = ids.find(start);
+        startSymbol = found == ids.end() ? UINT32_MAX : found->second;
+
+        dense = pairStride <= DenseLimit;
+        std::unordered_map<uint64_t, uint32_t> pairOf;
+        std::vector<Pair> bodies;
+        std::vector<std::vector<uint32_t>> headsOf;
+        byteTerminal.fill(UINT32_MAX);
+        rulesOf.resize(pairStride);
+        for (const auto& [head, prods] : grammar) {
+            uint32_t A = ids[head];
+            for (const auto& prod : prods) {
+                if (prod.size() == 1) {
+                    if (ids.count(prod[0])) throw std::invalid_argument("grammar is not in Chomsky normal form");
+                    auto [it, added] = terminals.emplace(prod[0], static_cast<uint32_t>(terminals.size()));
+                    if (added) terminalMasks.resize(terminalMasks.size() + words, 0);
+                    if (prod[0].size() == 1) byteTerminal[static_cast<unsigned char>(prod[0][0])] = it->second;
+                    setBit(&terminalMasks[size_t(it->second) * words], A);
+                    continue;
+                }
+                uint32_t B = ids[prod[0]], C = ids[prod[1]];
+                auto [it, added] = pairOf.emplace((uint64_t(B) << 32) | C, static_cast<uint32_t>(bodies.size()));
+                if (added) {
+                    bodies.push_back({B, C});
+                    headsOf.emplace_back();
+                }
+                headsOf[it->second].push_back(A);
+                rulesOf[A].push_back({B, C});
+            }
+        }
+        if (!dense) {
+            buildPartnerLists(bodies, headsOf);
+            return;
+        }
+
+        partners.assign(pairStride * words, 0);
+        pairIndex.assign(pairStride * pairStride, UINT32_MAX);
+        masks.assign(bodies.size() * words, 0);
+        for (uint32_t pair = 0; pair < bodies.size(); ++pair) {
+            const auto [B, C] = bodies[pair];
+            pairIndex[B * pairStride + C] = pair;
+            setBit(&partners[size_t(B) * words], C);
+            for (uint32_t A : headsOf[pair]) setBit(&masks[size_t(pair) * words], A);
+        }
+
+        // chunkPartners for chunk c and byte b is the union of partners[B]
+        // over the bits B = 8c + j set in b, built from b without its
+        // lowest bit.
+        chunkPartners.assign(words * 8 * 256 * words, 0);
+        for (size_t c = 0; c < words * 8; ++c) {
+            for (uint32_t b = 1; b < 256; ++b) {
+                uint64_t* out = &chunkPartners[(c * 256 + b) * words];
+                const uint64_t* rest = &chunkPartners[(c * 256 + (b & (b - 1))) * words];
+                size_t B = c * 8 + __builtin_ctz(b);
+                for (size_t v = 0; v < words; ++v) out[v] = rest[v] | (B < pairStride ? partners[B * words + v] : 0);
+            }
+        }
+    }
+
+    size_t nonTerminalCount() const { return nonTerminals.size(); }
+
+    // The single-word calls keep one chart per calling thread, and with it
+    // the cache, between words.
+    bool recognize(std::string_view word) const {
+        thread_local Chart chart;
+        return recognizeBytes(word, chart, nullptr);
+    }
+
+    bool recognize(const std::vector<CNFConverter::Symbol>& word) const {
+        thread_local Chart chart;
+        return recognizeSymbols(word, chart, nullptr);
+    }
+
+    // One word, with the cells of each span length spread over the pool.
+    bool recognize(std::string_view word, ThreadPool& pool) const {
+        thread_local Chart chart;
+        return recognizeBytes(word, chart, &pool);
+    }
+
+    // Many words, spread over the pool a word at a time, each filled row by
+    // row on the chart of the thread that takes it. result[i] is 1 if
+    // batch[i] is in the language.
+    std::vector<uint8_t> recognizeAll(const std::vector<std::string>& batch,
+                                      ThreadPool& pool = ThreadPool::Default()) const {
+        std::vector<uint8_t> result(batch.size(), 0);
+        size_t grain = std::max<size_t>(1, batch.size() / (pool.Size() * 8));
+        pool.ParallelFor(batch.size(), grain, [&](size_t begin, size_t end) {
+            thread_local Chart chart;
+            for (size_t i = begin; i < end; ++i) result[i] = recognizeBytes(batch[i], chart, nullptr);
+        });
+        return result;
+    }
+
+    // A parse of the word, if it is in the language.
+    std::optional<ParseTree> parse(std::string_view word) const {
+        std::vector<uint32_t> tokens;
+        if (!tokenize(word, tokens)) return std::nullopt;
+        return parseTokens(tokens);
+    }
+
+    std::optional<ParseTree> parse(const std::vector<CNFConverter::Symbol>& word) const {
+        std::vector<uint32_t> tokens;
+        if (!tokenize(word, tokens)) return std::nullopt;
+        return parseTokens(tokens);
+    }
+
+private:
+    struct Pair {
+        uint32_t left;
+        uint32_t right;
+    };
+
+    // Above this many nonterminals the pair tables are kept sparse.
+    static constexpr size_t DenseLimit = 1024;
+
+    struct Partner {
+        uint32_t right;
+        uint32_t pair;
+    };
+
+    // Interns the contents of non-empty cells and remembers, for pairs of
+    // interned contents, the heads combineSplit gives them. In most grammars
+    // cells take few distinct values, so most splits cost one lookup. The
+    // tables are open addressing with linear probing; they stop growing at
+    // a fixed size and are kept across words until then.
+    struct CellCache {
+        static constexpr uint32_t None = UINT32_MAX;
+        static constexpr size_t MaxContents = size_t(1) << 16;
+        static constexpr size_t MaxPairs = size_t(1) << 20;
+
+        uint64_t owner = 0;
+        // Changes whenever the tables are cleared, so ids from two fillings
+        // of the cache are never taken for each other.
+        uint64_t epoch = 0;
+        size_t words = 0;
+        size_t contentCount = 0;
+        std::vector<uint64_t> contents;
+        // contentSlots holds id + 1, or 0 for an empty slot.
+        std::vector<uint32_t> contentSlots;
+        size_t pairCount = 0;
+        std::vector<uint64_t> pairKeys;
+        std::vector<uint32_t> pairValues;
+        std::vector<uint64_t> scratch;
+
+        void reset(uint64_t parser, size_t cellWords) {
+            if (owner == parser && contentCount < MaxContents && pairCount < MaxPairs) return;
+            owner = parser;
+            epoch = nextIdentity()++;
+            words = cellWords;
+            scratch.resize(words);
+            contentCount = 0;
+            contents.clear();
+            contentSlots.assign(1024, 0);
+            pairCount = 0;
+            pairKeys.assign(4096, UINT64_MAX);
+            pairValues.assign(4096, None);
+        }
+
+        static size_t hash(uint64_t key) { return static_cast<size_t>((key * 0x9e3779b97f4a7c15ull) >> 20); }
+
+        size_t contentHash(const uint64_t* bits) const {
+            uint64_t h = 0;
+            for (size_t w = 0; w < words; ++w) h = (h ^ bits[w]) * 0x100000001b3ull + w;
+            return hash(h);
+        }
+
+        // The id of these contents, added if new; None once the table is full.
+        uint32_t intern(const uint64_t* bits) {
+            size_t mask = contentSlots.size() - 1;
+            for (size_t slot = contentHash(bits) & mask;; slot = (slot + 1) & mask) {
+                uint32_t id = contentSlots[slot];
+                if (id == 0) break;
+                if (std::equal(bits, bits + words, &contents[(id - 1) * words])) return id - 1;
+            }
+            if (contentCount >= MaxContents) return None;
+            contents.insert(contents.end(), bits, bits + words);
+            uint32_t id = static_cast<uint32_t>(contentCount++);
+            if (contentCount * 2 > contentSlots.size()) {
+                contentSlots.assign(contentSlots.size() * 2, 0);
+                rehashContents();
+            } else {
+                contentSlots[slotFor(content(id))] = id + 1;
+            }
+            return id;
+        }
+
+        const uint64_t* content(uint32_t id) const { return &contents[size_t(id) * words]; }
+
+        uint32_t findPair(uint32_t left, uint32_t right) const {
+            uint64_t key = (uint64_t(left) << 32) | right;
+            size_t mask = pairKeys.size() - 1;
+            for (size_t slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+                if (pairKeys[slot] == key) return pairValues[slot];
+                if (pairKeys[slot] == UINT64_MAX) return None;
+            }
+        }
+
+        void addPair(uint32_t left, uint32_t right, uint32_t id) {
+            if (pairCount >= MaxPairs) return;
+            if ((pairCount + 1) * 2 > pairKeys.size()) growPairs();
+            insertPair((uint64_t(left) << 32) | right, id);
+            ++pairCount;
+        }
+
+    private:
+        size_t slotFor(const uint64_t* bits) const {
+            size_t mask = contentSlots.size() - 1;
+            size_t slot = contentHash(bits) & mask;
+            while (contentSlots[slot] != 0) slot = (slot + 1) & mask;
+            return slot;
+        }
+
+        void rehashContents() {
+            for (size_t id = 0; id < contentCount; ++id) {
+                contentSlots[slotFor(&contents[id * words])] = static_cast<uint32_t>(id + 1);
+            }
+        }
+
+        void insertPair(uint64_t key, uint32_t id) {
+            size_t mask = pairKeys.size() - 1;
+            size_t slot = hash(key) & mask;
+            while (pairKeys[slot] != UINT64_MAX) slot = (slot + 1) & mask;
+            pairKeys[slot] = key;
+            pairValues[slot] = id;
+        }
+
+        void growPairs() {
+            std::vector<uint64_t> keys(pairKeys.size() * 2, UINT64_MAX);
+            std::vector<uint32_t> values(pairKeys.size() * 2, None);
+            keys.swap(pairKeys);
+            values.swap(pairValues);
+            for (size_t slot = 0; slot < keys.size(); ++slot) {
+                if (keys[slot] != UINT64_MAX) insertPair(keys[slot], values[slot]);
+            }
+        }
+    };
+
+    // Cell (i, length) covers tokens i .. i + length - 1; cells are stored
+    // row by row, the cells starting at i in order of length. Positions
+    // between tokens are points: cell(i, length) spans points i to
+    // i + length.
+    struct Chart {
+        size_t n = 0;
+        size_t words = 0;
+        std::vector<uint64_t> bits;
+        // Bitsets over points, rowWords words per row: leftEnds row i has p
+        // set if cell(i, p - i) is non-empty, and rightStarts row j has p set
+        // if cell(p, j + 1 - p) is. touched row i has p set once some split
+        // has written cell(i, p - i).
+        size_t rowWords = 0;
+        std::vector<uint64_t> leftEnds;
+        std::vector<uint64_t> rightStarts;
+        std::vector<uint64_t> touched;
+        // idFrom row i at p: the cache id of cell(i, p - i) if it is non-empty.
+        std::vector<uint32_t> idFrom;
+        CellCache cache;
+
+        void reset(size_t tokens, size_t cellWords, uint64_t parser) {
+            n = tokens;
+            words = cellWords;
+            bits.resize(n * (n + 1) / 2 * words);
+            rowWords = (n + 1 + 63) / 64;
+            leftEnds.assign(n * rowWords, 0);
+            rightStarts.assign(n * rowWords, 0);
+            touched.assign(n * rowWords, 0);
+            idFrom.resize(n * (n + 1));
+            cache.reset(parser, words);
+        }
+
+        bool nonEmpty(size_t i, size_t length) const {
+            return testBit(&leftEnds[i * rowWords], static_cast<uint32_t>(i + length));
+        }
+
+        size_t index(size_t i, size_t length) const { return i * n - i * (i - 1) / 2 + length - 1; }
+        uint64_t* cell(size_t i, size_t length) { return &bits[index(i, length) * words]; }
+        const uint64_t* cell(size_t i, size_t length) const { return &bits[index(i, length) * words]; }
+    };
+
+    // Tells the parsers apart for the charts threads keep between calls.
+    uint64_t identity = nextIdentity()++;
+    std::vector<CNFConverter::Symbol> nonTerminals;
+    std::unordered_map<CNFConverter::Symbol, uint32_t> ids;
+    std::unordered_map<CNFConverter::Symbol, uint32_t> terminals;
+    std::array<uint32_t, 256> byteTerminal;
+    size_t pairStride = 0;
+    size_t words = 0;
+    uint32_t startSymbol = UINT32_MAX;
+    // terminalMasks[t * words ..]: the A with A -> t.
+    std::vector<uint64_t> terminalMasks;
+    // partners[B * words ..]: the C with some rule A -> B C.
+    std::vector<uint64_t> partners;
+    // chunkPartners[(c * 256 + b) * words ..]: the C that pair with some B
+    // in the byte b of chunk c of a cell, so a split can skip eight left
+    // symbols at once when none of them pairs with the right cell.
+    std::vector<uint64_t> chunkPartners;
+    // pairIndex[B * pairStride + C]: which mask in masks holds the heads of
+    // A -> B C.
+    std::vector<uint32_t> pairIndex;
+    std::vector<uint64_t> masks;
+    // Without dense tables: partnerList[partnerStart[B] .. partnerStart[B + 1]]
+    // are the C with some A -> B C, by increasing C, and
+    // headList[headStart[pair] ..] the heads of that pair.
+    bool dense = true;
+    std::vector<uint32_t> partnerStart;
+    std::vector<Partner> partnerList;
+    std::vector<uint32_t> headStart;
+    std::vector<uint32_t> headList;
+    std::vector<std::vector<Pair>> rulesOf;
+
+    void internNonTerminal(const CNFConverter::Symbol& symbol) {
+        if (ids.emplace(symbol, static_cast<uint32_t>(nonTerminals.size())).second) nonTerminals.push_back(symbol);
+    }
+
+    static std::atomic<uint64_t>& nextIdentity() {
+        static std::atomic<uint64_t> next{1};
+        return next;
+    }
+
+    void buildPartnerLists(const std::vector<Pair>& bodies, const std::vector<std::vector<uint32_t>>& headsOf) {
+        partnerStart.assign(pairStride + 1, 0);
+        for (const Pair& body : bodies) partnerStart[body.left + 1]++;
+        for (size_t B = 0; B < pairStride; ++B) partnerStart[B + 1] += partnerStart[B];
+        partnerList.resize(bodies.size());
+        std::vector<uint32_t> fill(partnerStart.begin(), partnerStart.end() - 1);
+        for (uint32_t pair = 0; pair < bodies.size(); ++pair) {
+            partnerList[fill[bodies[pair].left]++] = {bodies[pair].right, pair};
+        }
+        for (size_t B = 0; B < pairStride; ++B) {
+            std::sort(partnerList.begin() + partnerStart[B], partnerList.begin() + partnerStart[B + 1],
+                      [](const Partner& x, const Partner& y) { return x.right < y.right; });
+        }
+        headStart.push_back(0);
+        for (const auto& heads : headsOf) {
+            headList.insert(headList.end(), heads.begin(), heads.end());
+            headStart.push_back(static_cast<uint32_t>(headList.size()));
+        }
+    }
+
+    static void setBit(uint64_t* bits, uint32_t bit) { bits[bit / 64] |= uint64_t(1) << (bit % 64); }
+    static bool testBit(const uint64_t* bits, uint32_t bit) { return (bits[bit / 64] >> (bit % 64)) & 1; }
+
+    bool tokenize(std::string_view word, std::vector<uint32_t>& tokens) const {
+        tokens.clear();
+        for (char c : word) {
+            uint32_t t = byteTerminal[static_cast<unsigned char>(c)];
+            if (t == UINT32_MAX) return false;
+            tokens.push_back(t);
+        }
+        return true;
+    }
+
+    bool tokenize(const std::vector<CNFConverter::Symbol>& word, std::vector<uint32_t>& tokens) const {
+        tokens.clear();
+        for (const auto& symbol : word) {
+            auto found = terminals.find(symbol);
+            if (found == terminals.end()) return false;
+            tokens.push_back(found->second);
+        }
+        return true;
+    }
+
+    bool recognizeBytes(std::string_view word, Chart& chart, ThreadPool* pool) const {
+        thread_local std::vector<uint32_t> tokens;
+        return tokenize(word, tokens) && accepts(tokens, chart, pool);
+    }
+
+    bool recognizeSymbols(const std::vector<CNFConverter::Symbol>& word, Chart& chart, ThreadPool* pool) const {
+        std::vector<uint32_t> tokens;
+        return tokenize(word, tokens) && accepts(tokens, chart, pool);
+    }
+
+    bool accepts(const std::vector<uint32_t>& tokens, Chart& chart, ThreadPool* pool) const {
+        if (tokens.empty() || startSymbol == UINT32_MAX) return false;
+        fill(tokens, chart, pool);
+        // Cells no split wrote keep whatever the last word left in them.
+        return chart.nonEmpty(0, tokens.size()) && testBit(chart.cell(0, tokens.size()), startSymbol);
+    }
+
+    void fill(const std::vector<uint32_t>& tokens, Chart& chart, ThreadPool* pool) const {
+        chart.reset(tokens.size(), words, identity);
+        if (pool && pool->Size() > 1) fillDiagonals(tokens, chart, *pool);
+        else fillRows(tokens, chart);
+    }
+
+    // Rows from the last token back. In row i the cells are finished in
+    // order of their end point p: every split that writes a cell ends its
+    // left part at an earlier point. Each finished, non-empty cell(i, p - i)
+    // is then the left part of a split with every non-empty cell starting
+    // at p, whose row is already done. Only real splits and written cells
+    // cost anything, and repeated pairs of cell contents come from the cache.
+    void fillRows(const std::vector<uint32_t>& tokens, Chart& chart) const {
+        const size_t n = tokens.size(), stride = n + 1;
+        for (size_t i = n; i-- > 0;) {
+            const uint64_t* heads = &terminalMasks[size_t(tokens[i]) * words];
+            std::copy(heads, heads + words, chart.cell(i, 1));
+            uint64_t* touched = &chart.touched[i * chart.rowWords];
+            setBit(touched, static_cast<uint32_t>(i + 1));
+
+            for (size_t p = i + 1; p <= n; ++p) {
+                uint64_t pending = touched[p / 64] >> (p % 64);
+                if (pending == 0) {
+                    p = (p / 64 + 1) * 64 - 1;
+                    continue;
+                }
+                p += __builtin_ctzll(pending);
+                if (p > n) break;
+                if (!markCell(chart, i, p - i, true) || p == n) continue;
+
+                uint32_t leftId = chart.idFrom[i * stride + p];
+                const uint64_t* left = chart.cell(i, p - i);
+                const uint64_t* rights = &chart.leftEnds[p * chart.rowWords];
+                for (size_t w = p / 64; w < chart.rowWords; ++w) {
+                    for (uint64_t ends = rights[w]; ends; ends &= ends - 1) {
+                        size_t e = w * 64 + __builtin_ctzll(ends);
+                        uint64_t* out = chart.cell(i, e - i);
+                        if (!testBit(touched, static_cast<uint32_t>(e))) {
+                            std::fill(out, out + words, 0);
+                            setBit(touched, static_cast<uint32_t>(e));
+                        }
+                        combineCached(chart.cache, leftId, chart.idFrom[p * stride + e], left, chart.cell(p, e - p),
+                                      out);
+                    }
+                }
+            }
+        }
+    }
+
+    // Diagonals of increasing length, the cells of each spread over the
+    // pool. The chart's cache interns each diagonal once it is done, on this
+    // thread, so its ids do not change while cells are being written; every
+    // thread keeps the pairs of ids it has combined in a cache of its own.
+    void fillDiagonals(const std::vector<uint32_t>& tokens, Chart& chart, ThreadPool& pool) const {
+        const size_t n = tokens.size();
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t* heads = &terminalMasks[size_t(tokens[i]) * words];
+            std::copy(heads, heads + words, chart.cell(i, 1));
+            markCell(chart, i, 1, true);
+        }
+        for (size_t length = 2; length <= n; ++length) {
+            size_t cells = n - length + 1;
+            auto run = [&](size_t begin, size_t end) {
+                CellCache& pairs = splitCache(chart);
+                for (size_t i = begin; i < end; ++i) combine(chart, pairs, i, length);
+            };
+            if (cells >= 64) pool.ParallelFor(cells, 16, run);
+            else run(0, cells);
+            for (size_t i = 0; i < cells; ++i) {
+                if (chart.nonEmpty(i, length)) {
+                    chart.idFrom[i * (n + 1) + i + length] = chart.cache.intern(chart.cell(i, length));
+                }
+            }
+        }
+    }
+
+    // The calling thread's cache for fillDiagonals, keyed by pairs of ids
+    // from the chart's cache.
+    CellCache& splitCache(const Chart& chart) const {
+        thread_local CellCache pairs;
+        pairs.reset(chart.cache.epoch, words);
+        return pairs;
+    }
+
+    // Records a finished cell in the split bitsets, interning it with
+    // cached; false if it is empty.
+    bool markCell(Chart& chart, size_t i, size_t length, bool cached) const {
+        const uint64_t* cell = chart.cell(i, length);
+        bool any = false;
+        for (size_t w = 0; w < words; ++w) any |= cell[w] != 0;
+        if (!any) return false;
+        chart.idFrom[i * (chart.n + 1) + i + length] = cached ? chart.cache.intern(cell) : CellCache::None;
+        setBit(&chart.leftEnds[i * chart.rowWords], static_cast<uint32_t>(i + length));
+        setBit(&chart.rightStarts[(i + length - 1) * chart.rowWords], static_cast<uint32_t>(i));
+        return true;
+    }
+
+    // cell(i, length) = the union over splits k and over B in cell(i, k),
+    // C in cell(i + k, length - k) of the heads of A -> B C, taken only
+    // over the splits where both parts are non-empty.
+    void combine(Chart& chart, CellCache& pairs, size_t i, size_t length) const {
+        const size_t stride = chart.n + 1;
+        uint64_t* out = chart.cell(i, length);
+        std::fill(out, out + words, 0);
+        const uint64_t* ends = &chart.leftEnds[i * chart.rowWords];
+        const uint64_t* starts = &chart.rightStarts[(i + length - 1) * chart.rowWords];
+        for (size_t w = (i + 1) / 64; w <= (i + length - 1) / 64; ++w) {
+            for (uint64_t points = ends[w] & starts[w]; points; points &= points - 1) {
+                size_t p = w * 64 + __builtin_ctzll(points);
+                combineCached(pairs, chart.idFrom[i * stride + p], chart.idFrom[p * stride + i + length],
+                              chart.cell(i, p - i), chart.cell(p, i + length - p), out);
+            }
+        }
+        markCell(chart, i, length, false);
+    }
+
+    // One split through the cache when both parts have ids.
+    void combineCached(CellCache& cache, uint32_t leftId, uint32_t rightId,
+                       const uint64_t* left, const uint64_t* right, uint64_t* out) const {
+        if (leftId == CellCache::None || rightId == CellCache::None) {
+            combineSplit(left, right, out);
+            return;
+        }
+        uint32_t heads = cache.findPair(leftId, rightId);
+        if (heads == CellCache::None) {
+            std::fill(cache.scratch.begin(), cache.scratch.end(), 0);
+            combineSplit(left, right, cache.scratch.data());
+            heads = cache.intern(cache.scratch.data());
+            if (heads == CellCache::None) {
+                for (size_t u = 0; u < words; ++u) out[u] |= cache.scratch[u];
+                return;
+            }
+            cache.addPair(leftId, rightId, heads);
+        }
+        const uint64_t* known = cache.content(heads);
+        for (size_t u = 0; u < words; ++u) out[u] |= known[u];
+    }
+
+    void combineSplit(const uint64_t* left, const uint64_t* right, uint64_t* out) const {
+        if (!dense) {
+            combineSparse(left, right, out);
+            return;
+        }
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t rest = left[w]; rest;) {
+                size_t shift = __builtin_ctzll(rest) & ~size_t(7);
+                rest &= ~(uint64_t(0xff) << shift);
+                combineChunk(w * 8 + shift / 8, (left[w] >> shift) & 0xff, right, out);
+            }
+        }
+    }
+
+    // The plain partner scan: every listed C of every B in left.
+    void combineSparse(const uint64_t* left, const uint64_t* right, uint64_t* out) const {
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = left[w]; bits; bits &= bits - 1) {
+                size_t B = w * 64 + __builtin_ctzll(bits);
+                for (uint32_t e = partnerStart[B]; e < partnerStart[B + 1]; ++e) {
+                    const Partner& partner = partnerList[e];
+                    if (!testBit(right, partner.right)) continue;
+                    for (uint32_t h = headStart[partner.pair]; h < headStart[partner.pair + 1]; ++h) {
+                        setBit(out, headList[h]);
+                    }
+                }
+            }
+        }
+    }
+
+    // The pairs whose left symbol is in the byte of chunk c of a cell.
+    void combineChunk(size_t c, uint32_t byte, const uint64_t* right, uint64_t* out) const {
+        const uint64_t* candidates = &chunkPartners[(c * 256 + byte) * words];
+        bool any = false;
+        for (size_t v = 0; v < words; ++v) any |= (candidates[v] & right[v]) != 0;
+        if (!any) return;
+
+        for (; byte; byte &= byte - 1) {
+            size_t B = c * 8 + __builtin_ctz(byte);
+            const uint64_t* with = &partners[B * words];
+            for (size_t v = 0; v < words; ++v) {
+                for (uint64_t cs = with[v] & right[v]; cs; cs &= cs - 1) {
+                    size_t C = v * 64 + __builtin_ctzll(cs);
+                    const uint64_t* heads = &masks[size_t(pairIndex[B * pairStride + C]) * words];
+                    for (size_t u = 0; u < words; ++u) out[u] |= heads[u];
+                }
+            }
+        }
+    }
+
+    std::optional<ParseTree> parseTokens(const std::vector<uint32_t>& tokens) const {
+        Chart chart;
+        if (!accepts(tokens, chart, nullptr)) return std::nullopt;
+        std::vector<CNFConverter::Symbol> terminalNames(terminals.size());
+        for (const auto& [name, t] : terminals) terminalNames[t] = name;
+        return build(chart, tokens, terminalNames, startSymbol, 0, tokens.size());
+    }
+
+    // The subtree for A over cell(i, length), which must derive it: the
+    // first split and rule, in rule order, whose two halves both derive.
+    ParseTree build(const Chart& chart, const std::vector<uint32_t>& tokens,
+                    const std::vector<CNFConverter::Symbol>& terminalNames,
+                    uint32_t A, size_t i, size_t length) const {
+        ParseTree tree{nonTerminals[A], {}};
+        if (length == 1) {
+            tree.children.push_back({terminalNames[tokens[i]], {}});
+            return tree;
+        }
+        for (size_t k = 1; k < length; ++k) {
+            if (!chart.nonEmpty(i, k) || !chart.nonEmpty(i + k, length - k)) continue;
+            for (const Pair& pair : rulesOf[A]) {
+                if (testBit(chart.cell(i, k), pair.left) && testBit(chart.cell(i + k, length - k), pair.right)) {
+                    tree.children.push_back(build(chart, tokens, terminalNames, pair.left, i, k));
+                    tree.children.push_back(build(chart, tokens, terminalNames, pair.right, i + k, length - k));
+                    return tree;
+                }
+            }
+        }
+        throw std::logic_error("CYK chart has no derivation for a marked cell");
+    }
+};
+
+#endif
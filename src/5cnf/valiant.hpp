@@ -0,0 +1,342 @@
+#ifndef VALIANT_H
+#define VALIANT_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "cnf.hpp"
+#include "../2DFA/ThreadPool.hpp"
+
+// Membership for a grammar in Chomsky normal form by Valiant's reduction of
+// CYK to Boolean matrix multiplication, in Okhotin's formulation (compute
+// and complete over halves of the table). The table is one bit matrix per
+// nonterminal, T_A[i][j] set when A derives tokens i .. j - 1; products of
+// blocks add, for every rule A -> B C, T_B[R][K] x T_C[K][C] into
+// T_A[R][C]. The matrices are (n + 1) x (n + 1) rounded up to a power of
+// two, at least 64, so memory is nonTerminals * size^2 / 8 bytes.
+//
+// Each 64 x 64 tile keeps the set of nonterminals with a bit in it, so a
+// product only runs for rules whose two blocks are non-empty and small
+// blocks cost a few words of bookkeeping. A product iterates the set bits
+// of the left block and ORs rows of the right one when the block is sparse,
+// and uses Four Russians tables (eight rows at a time, a table of all 256
+// unions) when it is dense. Large products are split over the pool by
+// column words.
+class ValiantRecognizer {
+public:
+    ValiantRecognizer(const CNFConverter::Grammar& grammar, const CNFConverter::Symbol& start) {
+        for (const auto& [A, prods] : grammar) {
+            internNonTerminal(A);
+            for (const auto& prod : prods) {
+                if (prod.size() == 2) {
+                    internNonTerminal(prod[0]);
+                    internNonTerminal(prod[1]);
+                } else if (prod.size() != 1) {
+                    throw std::invalid_argument("grammar is not in Chomsky normal form");
+                }
+            }
+        }
+        count = nonTerminals.size();
+        symbolWords = (count + 63) / 64;
+        auto found = ids.find(start);
+        startSymbol = found == ids.end() ? UINT32_MAX : found->second;
+
+        std::unordered_map<uint64_t, uint32_t> pairOf;
+        byteTerminal.fill(UINT32_MAX);
+        for (const auto& [head, prods] : grammar) {
+            uint32_t A = ids[head];
+            for (const auto& prod : prods) {
+                if (prod.size() == 1) {
+                    if (ids.count(prod[0])) throw std::invalid_argument("grammar is not in Chomsky normal form");
+                    auto [it, added] = terminals.emplace(prod[0], static_cast<uint32_t>(terminalHeads.size()));
+                    if (added) terminalHeads.emplace_back();
+                    if (prod[0].size() == 1) byteTerminal[static_cast<unsigned char>(prod[0][0])] = it->second;
+                    terminalHeads[it->second].push_back(A);
+                    continue;
+                }
+                uint32_t B = ids[prod[0]], C = ids[prod[1]];
+                auto [it, added] = pairOf.emplace((uint64_t(B) << 32) | C, static_cast<uint32_t>(pairs.size()));
+                if (added) pairs.push_back({B, C, {}});
+                pairs[it->second].heads.push_back(A);
+            }
+        }
+
+        partnerStart.assign(count + 1, 0);
+        for (const Pair& pair : pairs) partnerStart[pair.left + 1]++;
+        for (size_t X = 0; X < count; ++X) partnerStart[X + 1] += partnerStart[X];
+        partnerList.resize(pairs.size());
+        std::vector<uint32_t> fill(partnerStart.begin(), partnerStart.end() - 1);
+        for (uint32_t q = 0; q < pairs.size(); ++q) partnerList[fill[pairs[q].left]++] = q;
+    }
+
+    size_t nonTerminalCount() const { return count; }
+
+    // A string is read one character per terminal.
+    bool recognize(std::string_view word, ThreadPool& pool = ThreadPool::Default()) const {
+        std::vector<uint32_t> tokens;
+        for (char c : word) {
+            uint32_t t = byteTerminal[static_cast<unsigned char>(c)];
+            if (t == UINT32_MAX) return false;
+            tokens.push_back(t);
+        }
+        return accepts(tokens, pool);
+    }
+
+    bool recognize(const std::vector<CNFConverter::Symbol>& word, ThreadPool& pool = ThreadPool::Default()) const {
+        std::vector<uint32_t> tokens;
+        for (const auto& symbol : word) {
+            auto found = terminals.find(symbol);
+            if (found == terminals.end()) return false;
+            tokens.push_back(found->second);
+        }
+        return accepts(tokens, pool);
+    }
+
+private:
+    struct Pair {
+        uint32_t left;
+        uint32_t right;
+        std::vector<uint32_t> heads;
+    };
+
+    // Products of blocks at least this wide are split over the pool.
+    static constexpr size_t ParallelSize = 256;
+
+    struct Table {
+        size_t size = 0;
+        size_t rowWords = 0;
+        size_t tiles = 0;
+        size_t symbolWords = 0;
+        std::vector<uint64_t> bits;
+        // tileSymbols for tile (ti, tj): the nonterminals A with a bit in
+        // rows 64 ti .. 64 ti + 63, columns 64 tj .. 64 tj + 63 of T_A.
+        std::vector<uint64_t> tileSymbols;
+        // Scratch for multiplyAdd, which runs on one thread at a time.
+        std::vector<uint64_t> leftSymbols;
+        std::vector<uint64_t> rightSymbols;
+        std::vector<uint32_t> active;
+
+        uint64_t* row(size_t A, size_t i) { return &bits[(A * size + i) * rowWords]; }
+        const uint64_t* row(size_t A, size_t i) const { return &bits[(A * size + i) * rowWords]; }
+        uint64_t* tile(size_t ti, size_t tj) { return &tileSymbols[(ti * tiles + tj) * symbolWords]; }
+
+        void mark(size_t A, size_t i, size_t word) {
+            tile(i / 64, word)[A / 64] |= uint64_t(1) << (A % 64);
+        }
+    };
+
+    std::vector<CNFConverter::Symbol> nonTerminals;
+    std::unordered_map<CNFConverter::Symbol, uint32_t> ids;
+    std::unordered_map<CNFConverter::Symbol, uint32_t> terminals;
+    std::array<uint32_t, 256> byteTerminal;
+    std::vector<std::vector<uint32_t>> terminalHeads;
+    size_t count = 0;
+    size_t symbolWords = 0;
+    uint32_t startSymbol = UINT32_MAX;
+    std::vector<Pair> pairs;
+    // partnerList[partnerStart[B] .. partnerStart[B + 1]]: the indices in
+    // pairs of the bodies B C.
+    std::vector<uint32_t> partnerStart;
+    std::vector<uint32_t> partnerList;
+
+    void internNonTerminal(const CNFConverter::Symbol& symbol) {
+        if (ids.emplace(symbol, static_cast<uint32_t>(nonTerminals.size())).second) nonTerminals.push_back(symbol);
+    }
+
+    bool accepts(const std::vector<uint32_t>& tokens, ThreadPool& pool) const {
+        if (tokens.empty() || startSymbol == UINT32_MAX) return false;
+        const size_t n = tokens.size();
+        Table table;
+        table.size = 64;
+        while (table.size < n + 1) table.size *= 2;
+        table.rowWords = table.size / 64;
+        table.tiles = table.size / 64;
+        table.symbolWords = symbolWords;
+        table.bits.assign(count * table.size * table.rowWords, 0);
+        table.tileSymbols.assign(table.tiles * table.tiles * symbolWords, 0);
+        table.leftSymbols.resize(symbolWords);
+        table.rightSymbols.resize(symbolWords);
+
+        for (size_t i = 0; i < n; ++i) {
+            for (uint32_t A : terminalHeads[tokens[i]]) {
+                table.row(A, i)[(i + 1) / 64] |= uint64_t(1) << ((i + 1) % 64);
+                table.mark(A, i, (i + 1) / 64);
+            }
+        }
+        compute(table, 0, table.size, pool);
+        return (table.row(startSymbol, 0)[n / 64] >> (n % 64)) & 1;
+    }
+
+    // Fills T over rows and columns [l, m), given the cells spanning the
+    // rows only through splits outside [l, m).
+    void compute(Table& table, size_t l, size_t m, ThreadPool& pool) const {
+        size_t half = (l + m) / 2;
+        if (m - l >= 4) {
+            compute(table, l, half, pool);
+            compute(table, half, m, pool);
+        }
+        complete(table, l, half, half, m, pool);
+    }
+
+    // Finishes T over rows [l, m) and columns [l2, m2), both of the same
+    // power-of-two size and both squares on the diagonal already finished,
+    // given the splits strictly between m and l2 already added. Rows and
+    // columns are split in halves B, C and D, E as in Okhotin.
+    void complete(Table& table, size_t l, size_t m, size_t l2, size_t m2, ThreadPool& pool) const {
+        if (m - l == 1) return;
+        size_t s = (m - l) / 2;
+        size_t b = l, c = l + s, d = l2, e = l2 + s;
+        complete(table, c, m, d, e, pool);
+        multiplyAdd(table, b, c, d, s, pool);
+        complete(table, b, c, d, e, pool);
+        multiplyAdd(table, c, d, e, s, pool);
+        complete(table, c, m, e, m2, pool);
+        multiplyAdd(table, b, c, e, s, pool);
+        multiplyAdd(table, b, d, e, s, pool);
+        complete(table, b, c, e, m2, pool);
+    }
+
+    // The union of the tile sets over the block of size s at (r0, c0).
+    void blockSymbols(Table& table, size_t r0, size_t c0, size_t s, std::vector<uint64_t>& out) const {
+        std::fill(out.begin(), out.end(), 0);
+        for (size_t ti = r0 / 64; ti <= (r0 + s - 1) / 64; ++ti) {
+            for (size_t tj = c0 / 64; tj <= (c0 + s - 1) / 64; ++tj) {
+                const uint64_t* symbols = table.tile(ti, tj);
+                for (size_t w = 0; w < symbolWords; ++w) out[w] |= symbols[w];
+            }
+        }
+    }
+
+    // For every rule A -> X Y: T_A[r0.., c0..] |= T_X[r0.., k0..] x T_Y[k0.., c0..],
+    // all blocks of size s.
+    void multiplyAdd(Table& table, size_t r0, size_t k0, size_t c0, size_t s, ThreadPool& pool) const {
+        blockSymbols(table, r0, k0, s, table.leftSymbols);
+        blockSymbols(table, k0, c0, s, table.rightSymbols);
+        table.active.clear();
+        for (size_t w = 0; w < symbolWords; ++w) {
+            for (uint64_t xs = table.leftSymbols[w]; xs; xs &= xs - 1) {
+                size_t X = w * 64 + __builtin_ctzll(xs);
+                for (uint32_t e = partnerStart[X]; e < partnerStart[X + 1]; ++e) {
+                    uint32_t Y = pairs[partnerList[e]].right;
+                    if ((table.rightSymbols[Y / 64] >> (Y % 64)) & 1) table.active.push_back(partnerList[e]);
+                }
+            }
+        }
+        if (table.active.empty()) return;
+
+        if (s < 64) {
+            multiplySmall(table, r0, k0, c0, s);
+            return;
+        }
+        size_t width = s / 64;
+        auto columns = [&](size_t w0, size_t w1) {
+            std::vector<uint64_t> out(s * (w1 - w0));
+            std::vector<uint64_t> lookup;
+            for (uint32_t q : table.active) {
+                multiplyLarge(table, pairs[q], r0, k0, c0, s, w0, w1, out, lookup);
+                for (uint32_t A : pairs[q].heads) {
+                    for (size_t i = 0; i < s; ++i) {
+                        uint64_t* target = table.row(A, r0 + i) + c0 / 64 + w0;
+                        const uint64_t* product = &out[i * (w1 - w0)];
+                        for (size_t u = 0; u < w1 - w0; ++u) {
+                            if (product[u] == 0) continue;
+                            target[u] |= product[u];
+                            table.mark(A, r0 + i, c0 / 64 + w0 + u);
+                        }
+                    }
+                }
+            }
+        };
+        if (s >= ParallelSize && pool.Size() > 1) {
+            pool.ParallelFor(width, std::max<size_t>(1, width / (pool.Size() * 2)), columns);
+        } else {
+            columns(0, width);
+        }
+    }
+
+    // Blocks narrower than a word: each row of a block is s bits of one word.
+    void multiplySmall(Table& table, size_t r0, size_t k0, size_t c0, size_t s) const {
+        const uint64_t mask = (uint64_t(1) << s) - 1;
+        for (uint32_t q : table.active) {
+            const Pair& pair = pairs[q];
+            for (size_t i = 0; i < s; ++i) {
+                uint64_t x = (table.row(pair.left, r0 + i)[k0 / 64] >> (k0 % 64)) & mask;
+                uint64_t product = 0;
+                for (; x; x &= x - 1) {
+                    size_t k = k0 + __builtin_ctzll(x);
+                    product |= table.row(pair.right, k)[c0 / 64] >> (c0 % 64);
+                }
+                product &= mask;
+                if (product == 0) continue;
+                for (uint32_t A : pair.heads) {
+                    table.row(A, r0 + i)[c0 / 64] |= product << (c0 % 64);
+                    table.mark(A, r0 + i, c0 / 64);
+                }
+            }
+        }
+    }
+
+    // out = T_X[r0.., k0..] x T_Y[k0.., c0..] restricted to column words
+    // w0 .. w1 - 1 of the block, s rows of w1 - w0 words.
+    void multiplyLarge(const Table& table, const Pair& pair, size_t r0, size_t k0, size_t c0, size_t s,
+                       size_t w0, size_t w1, std::vector<uint64_t>& out, std::vector<uint64_t>& lookup) const {
+        const size_t width = w1 - w0, kWords = s / 64, kw = k0 / 64, cw = c0 / 64 + w0;
+        std::fill(out.begin(), out.end(), 0);
+
+        size_t bitsSet = 0;
+        for (size_t i = 0; i < s; ++i) {
+            const uint64_t* x = table.row(pair.left, r0 + i) + kw;
+            for (size_t v = 0; v < kWords; ++v) bitsSet += __builtin_popcountll(x[v]);
+        }
+        if (bitsSet == 0) return;
+
+        // Row ORs cost one right row per set bit; Four Russians costs 256
+        // unions per eight rows of the right block and one lookup per byte
+        // of the left one.
+        if (bitsSet <= s / 8 * (256 + s)) {
+            for (size_t i = 0; i < s; ++i) {
+                const uint64_t* x = table.row(pair.left, r0 + i) + kw;
+                uint64_t* o = &out[i * width];
+                for (size_t v = 0; v < kWords; ++v) {
+                    for (uint64_t bits = x[v]; bits; bits &= bits - 1) {
+                        const uint64_t* y = table.row(pair.right, k0 + v * 64 + __builtin_ctzll(bits)) + cw;
+                        for (size_t u = 0; u < width; ++u) o[u] |= y[u];
+                    }
+                }
+            }
+            return;
+        }
+
+        // Tables for the eight bytes of one word of left columns at a
+        // time, so each output row takes eight lookups while it is cached.
+        lookup.assign(8 * 256 * width, 0);
+        for (size_t v = 0; v < kWords; ++v) {
+            for (size_t g = 0; g < 8; ++g) {
+                uint64_t* group = &lookup[g * 256 * width];
+                for (uint32_t b = 1; b < 256; ++b) {
+                    const uint64_t* rest = &group[(b & (b - 1)) * width];
+                    const uint64_t* y = table.row(pair.right, k0 + v * 64 + g * 8 + __builtin_ctz(b)) + cw;
+                    uint64_t* entry = &group[b * width];
+                    for (size_t u = 0; u < width; ++u) entry[u] = rest[u] | y[u];
+                }
+            }
+            for (size_t i = 0; i < s; ++i) {
+                uint64_t x = table.row(pair.left, r0 + i)[kw + v];
+                if (x == 0) continue;
+                uint64_t* o = &out[i * width];
+                for (size_t g = 0; g < 8; ++g, x >>= 8) {
+                    if ((x & 0xff) == 0) continue;
+                    const uint64_t* entry = &lookup[(g * 256 + (x & 0xff)) * width];
+                    for (size_t u = 0; u < width; ++u) o[u] |= entry[u];
+                }
+            }
+        }
+    }
+};
+
+#endif
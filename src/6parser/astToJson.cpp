@@ -1,121 +1,267 @@
 #include "include/astToJson.h"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-json astToJson(const ASTNode* node) {
-    switch (node->type) {
-        case ASTNodeType::Program: {
-            auto* n = dynamic_cast<const ProgramNode*>(node);
-            json j = { {"type", "Program"}, {"statements", json::array()} };
-            for (const auto& stmt : n->statements)
-                j["statements"].push_back(astToJson(stmt.get()));
-            return j;
+namespace {
+
+// Writes JSON text straight into a string, optionally handing it to a stream
+// whenever a statement has been completed and the buffer has grown large.
+class JsonWriter {
+public:
+    JsonWriter(std::string& out, std::ostream* stream = nullptr) : out(out), stream(stream) {}
+
+    void write(const ASTNode* node) { visitNode(node, *this); }
+
+    void flush() {
+        if (!stream) return;
+        stream->write(out.data(), static_cast<std::streamsize>(out.size()));
+        out.clear();
+    }
+
+    void operator()(const ProgramNode& n) {
+        out += "{\"statements\":";
+        statements(n.statements);
+        out += ",\"type\":\"Program\"}";
+    }
+
+    void operator()(const LoadStmtNode& n) {
+        field("id", n.id, '{');
+        field("path", n.path);
+        out += ",\"type\":\"Load\"}";
+    }
+
+    void operator()(const SetStmtNode& n) {
+        field("amount", n.amount, '{');
+        out += ",\"type\":\"Set\"";
+        field("unit", n.unit);
+        out += '}';
+    }
+
+    void operator()(const TransformStmtNode& n) {
+        field("column", n.column, '{');
+        out += ",\"interval\":";
+        field("amount", n.intervalAmount, '{');
+        field("unit", n.intervalUnit);
+        out += '}';
+        field("table", n.table);
+        out += ",\"type\":\"Transform\"}";
+    }
+
+    // params and args are JSON objects: keys sorted, the last duplicate wins.
+    void operator()(const ForecastStmtNode& n) {
+        field("column", n.column, '{');
+        field("model", n.model);
+        out += ",\"params\":";
+        if (n.params.empty()) {
+            out += "null";
+        } else {
+            object(n.params);
         }
-        case ASTNodeType::Load: {
-            auto* n = dynamic_cast<const LoadStmtNode*>(node);
-            return { {"type", "Load"}, {"id", n->id}, {"path", n->path} };
+        field("table", n.table);
+        out += ",\"type\":\"Forecast\"}";
+    }
+
+    void operator()(const StreamStmtNode& n) {
+        field("id", n.id, '{');
+        field("path", n.path);
+        out += ",\"type\":\"Stream\"}";
+    }
+
+    void operator()(const SelectStmtNode& n) {
+        field("column", n.column, '{');
+        if (n.op && n.dateExpr) {
+            out += ",\"condition\":";
+            field("date", *n.dateExpr, '{');
+            field("op", *n.op);
+            out += '}';
         }
-        case ASTNodeType::Set: {
-            auto* n = dynamic_cast<const SetStmtNode*>(node);
-            return { {"type", "Set"}, {"amount", n->amount}, {"unit", n->unit} };
+        field("table", n.table);
+        out += ",\"type\":\"Select\"}";
+    }
+
+    void operator()(const PlotStmtNode& n) {
+        out += "{\"args\":";
+        object(n.args);
+        field("function", n.function);
+        out += ",\"type\":\"Plot\"}";
+    }
+
+    void operator()(const ExportStmtNode& n) {
+        out += '{';
+        if (n.column) {
+            field("column", *n.column, '\0');
+            out += ',';
         }
-        case ASTNodeType::Transform: {
-            auto* n = dynamic_cast<const TransformStmtNode*>(node);
-            return {
-                {"type", "Transform"},
-                {"table", n->table},
-                {"column", n->column},
-                {"interval", {
-                    {"amount", n->intervalAmount},
-                    {"unit", n->intervalUnit}
-                }}
-            };
-        }        
-        case ASTNodeType::Forecast: {
-            auto* n = dynamic_cast<const ForecastStmtNode*>(node);
-            json paramsJson;
-            for (const auto& p : n->params)
-                paramsJson[p.first] = p.second;
-        
-            return {
-                {"type", "Forecast"},
-                {"table", n->table},
-                {"column", n->column},
-                {"model", n->model},
-                {"params", paramsJson}
-            };
+        field("table", n.table, '\0');
+        field("to", n.target);
+        out += ",\"type\":\"Export\"}";
+    }
+
+    void operator()(const LoopStmtNode& n) {
+        out += "{\"body\":";
+        statements(n.body);
+        field("from", n.from);
+        field("to", n.to);
+        out += ",\"type\":\"Loop\"";
+        field("var", n.var);
+        out += '}';
+    }
+
+    void operator()(const CleanStmtNode& n) {
+        bool remove = n.action == CleanActionType::Remove;
+        field("action", remove ? "remove" : "replace", '{');
+        field("column", n.column);
+        field("target", n.targetValue);
+        out += ",\"type\":\"Clean\"";
+        if (!remove) field("with", n.replaceWith);
+        out += '}';
+    }
+
+    void operator()(const ASTNode&) {
+        out += "{\"type\":\"Unknown\"}";
+    }
+
+private:
+    static constexpr size_t flushThreshold = 64 * 1024;
+
+    std::string& out;
+    std::ostream* stream;
+
+    template <typename Value>
+    void field(std::string_view key, const Value& value, char before = ',') {
+        if (before) out += before;
+        string(key);
+        out += ':';
+        scalar(value);
+    }
+
+    void scalar(std::string_view value) { string(value); }
+    void scalar(const char* value) { string(value); }
+
+    void scalar(int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    void statements(const ArenaVector<ASTNodePtr>& nodes) {
+        out += '[';
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (i) out += ',';
+            write(nodes[i]);
+            if (out.size() >= flushThreshold) flush();
         }
-        
-        case ASTNodeType::Stream: {
-            auto* n = dynamic_cast<const StreamStmtNode*>(node);
-            return { {"type", "Stream"}, {"id", n->id}, {"path", n->path} };
+        out += ']';
+    }
+
+    template <typename Value>
+    void object(const ArenaVector<std::pair<std::string_view, Value>>& pairs) {
+        std::vector<const std::pair<std::string_view, Value>*> sorted;
+        sorted.reserve(pairs.size());
+        for (const auto& pair : pairs) sorted.push_back(&pair);
+        std::stable_sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) { return a->first < b->first; });
+
+        char before = '{';
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (i + 1 < sorted.size() && sorted[i + 1]->first == sorted[i]->first) continue;
+            field(sorted[i]->first, sorted[i]->second, before);
+            before = ',';
         }
-        case ASTNodeType::Select: {
-            auto* n = dynamic_cast<const SelectStmtNode*>(node);
-            json j = {
-                {"type", "Select"},
-                {"table", n->table},
-                {"column", n->column}
-            };
-            if (n->op && n->dateExpr) {
-                j["condition"] = {
-                    {"op", *n->op},
-                    {"date", *n->dateExpr}
-                };
+        if (sorted.empty()) out += '{';
+        out += '}';
+    }
+
+    // Same escaping as nlohmann::json::dump() with ensure_ascii off: named
+    // escapes, \u00XX for other control characters, UTF-8 copied as is.
+    void string(std::string_view s) {
+        out += '"';
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            switch (c) {
+                case '\b': out += "\\b"; continue;
+                case '\t': out += "\\t"; continue;
+                case '\n': out += "\\n"; continue;
+                case '\f': out += "\\f"; continue;
+                case '\r': out += "\\r"; continue;
+                case '"': out += "\\\""; continue;
+                case '\\': out += "\\\\"; continue;
             }
-            return j;
-        }
-        case ASTNodeType::Plot: {
-            auto* n = dynamic_cast<const PlotStmtNode*>(node);
-            json argsJson = json::object();
-            for (auto& arg : n->args)
-                argsJson[arg.first] = arg.second;
-            return { {"type", "Plot"}, {"function", n->function}, {"args", argsJson} };
-        }
-        case ASTNodeType::Export: {
-            auto* n = dynamic_cast<const ExportStmtNode*>(node);
-            json j = {
-                {"type", "Export"},
-                {"table", n->table},
-                {"to", n->target}
-            };
-            if (n->column.has_value()) {
-                j["column"] = *n->column;
+            if (c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            } else if (c < 0x80) {
+                out += static_cast<char>(c);
+            } else {
+                size_t length = utf8Length(s, i);
+                out.append(s.data() + i, length);
+                i += length - 1;
             }
-            return j;
         }
-        
-        case ASTNodeType::Loop: {
-            auto* n = dynamic_cast<const LoopStmtNode*>(node);
-            json body = json::array();
-            for (const auto& stmt : n->body)
-                body.push_back(astToJson(stmt.get()));
-            return {
-                {"type", "Loop"},
-                {"var", n->var},
-                {"from", n->from},
-                {"to", n->to},
-                {"body", body}
-            };
+        out += '"';
+    }
+
+    // Length of the well-formed UTF-8 sequence starting at s[i]. Reports the
+    // first offending byte the way nlohmann's type_error 316 does.
+    static size_t utf8Length(std::string_view s, size_t i) {
+        unsigned char lead = static_cast<unsigned char>(s[i]);
+        size_t length = 0;
+        unsigned char low = 0x80, high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) length = 2;
+        else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        } else {
+            invalidByte(i, lead);
         }
-        case ASTNodeType::Clean: {
-            auto* n = dynamic_cast<const CleanStmtNode*>(node);
-            if (n->action == CleanActionType::Remove) {
-                return {
-                    {"type", "Clean"},
-                    {"action", "remove"},
-                    {"target", n->targetValue},
-                    {"column", n->column}
-                };
-            } else {
-                return {
-                    {"type", "Clean"},
-                    {"action", "replace"},
-                    {"target", n->targetValue},
-                    {"column", n->column},
-                    {"with", n->replaceWith}
-                };
-            }
+
+        for (size_t k = 1; k < length; ++k) {
+            if (i + k >= s.size())
+                throw std::runtime_error("[json.exception.type_error.316] incomplete UTF-8 string; last byte: 0x" +
+                                         hexByte(static_cast<unsigned char>(s.back())));
+            unsigned char c = static_cast<unsigned char>(s[i + k]);
+            if (c < low || c > high) invalidByte(i + k, c);
+            low = 0x80;
+            high = 0xBF;
         }
-        default:
-            return { {"type", "Unknown"} };
+        return length;
+    }
+
+    [[noreturn]] static void invalidByte(size_t index, unsigned char byte) {
+        throw std::runtime_error("[json.exception.type_error.316] invalid UTF-8 byte at index " +
+                                 std::to_string(index) + ": 0x" + hexByte(byte));
+    }
+
+    static std::string hexByte(unsigned char byte) {
+        static const char hex[] = "0123456789ABCDEF";
+        return {hex[byte >> 4], hex[byte & 0xF]};
     }
+};
+
+} // namespace
+
+void astToJson(const ASTNode* node, std::string& out) {
+    JsonWriter(out).write(node);
+}
+
+void astToJson(const ASTNode* node, std::ostream& out) {
+    std::string buffer;
+    JsonWriter writer(buffer, &out);
+    writer.write(node);
+    writer.flush();
+}
+
+std::string astToJson(const ASTNode* node) {
+    std::string out;
+    astToJson(node, out);
+    return out;
 }
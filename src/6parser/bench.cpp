@@ -0,0 +1,531 @@
+// Lexer and parser benchmark.
+// Build: g++ -std=c++17 -O2 bench.cpp -o bench
+// Usage: bench [lex|ast|ast-legacy] [megabytes]
+//   lex         lexer throughput against the regex lexer, allocations per token
+//               with owned and with viewed token values
+//   ast         parse + destroy time and peak RSS of the arena AST
+//   ast-legacy  the same for the unique_ptr AST it replaced
+#include "lexer.cpp"
+#include "parser.cpp"
+#include "include/token_patterns.h"
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Every heap allocation in the process goes through here and is counted.
+static size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+// GCC takes the free() below for a mismatch with operator new wherever it
+// inlines a delete, though both go through malloc.
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+// Generates a syntactically valid ChronoLang script of at least `bytes` bytes.
+std::string makeScript(size_t bytes) {
+    std::string out;
+    for (int i = 0; out.size() < bytes; ++i) {
+        std::string t = "table_" + std::to_string(i % 97);
+        out += "LOAD " + t + " FROM \"data/" + t + ".csv\"\n";
+        out += "SET WINDOW = " + std::to_string(i % 30 + 1) + "d\n";
+        out += "TREND(" + t + ".amount) -> forecast_next(" + std::to_string(i % 14 + 1) + "h)\n";
+        out += "FORECAST " + t + ".amount USING ARIMA(model_order=2, seasonal_order=" + std::to_string(i % 5) + ")\n";
+        out += "SELECT " + t + ".amount WHERE DATE >= \"2024-01-01\"\n";
+        out += "PLOT LINEPLOT(data=[[1.5, 2.25], [3, 4]], title=\"Run " + std::to_string(i) + "\")\n";
+        out += "for j in 1 to 3 { EXPORT " + t + ".amount TO \"out_${j}.csv\" }\n";
+    }
+    return out;
+}
+
+// Token as it was before values became views into the Source: it copies
+// its text into a std::string of its own.
+struct OwnedToken {
+    TokenType type;
+    std::string value;
+    int line;
+    int column;
+
+    OwnedToken(TokenType type, const std::string& value, int line, int column)
+        : type(type), value(value), line(line), column(column) {}
+};
+
+// The original tokenizer: one std::regex per pattern per token, applied to a
+// copy of the remaining input, emitting owned tokens. Kept as the reference
+// for output and speed.
+std::vector<OwnedToken> legacyTokenize(const std::string& input) {
+    std::vector<OwnedToken> tokens;
+    std::smatch match;
+    size_t pos = 0;
+    int line = 1, column = 1;
+    auto advance = [&](const std::string& value) {
+        for (char c : value) {
+            if (c == '\n') { line++; column = 1; } else { column++; }
+            pos++;
+        }
+    };
+
+    while (pos < input.size()) {
+        std::string remaining = input.substr(pos);
+        bool matched = false;
+
+        if (std::isspace(input[pos])) {
+            advance(std::string(1, input[pos]));
+            continue;
+        }
+
+        for (const auto& [type, pattern] : tokenPatterns) {
+            std::regex regex("^" + std::string(pattern));
+            if (std::regex_search(remaining, match, regex)) {
+                std::string value = match[0];
+                TokenType finalType = type;
+                if (type == TokenType::ID) {
+                    std::string upper;
+                    for (char c : value) upper += std::toupper(c);
+                    for (const auto& [keyword, keywordType] : keywordTable)
+                        if (keyword == upper) finalType = keywordType;
+                }
+                tokens.emplace_back(finalType, value, line, column);
+                advance(value);
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched) advance(std::string(1, input[pos]));
+    }
+
+    tokens.emplace_back(TokenType::END_OF_FILE, "", line, column);
+    return tokens;
+}
+
+// The AST before it moved to an arena: nodes with virtual destructors, owned
+// through unique_ptr, and std::vectors and interned std::strings allocated
+// one by one. Kept, with the old parser for the statements makeScript
+// writes, as the reference for bench ast.
+namespace legacy {
+
+struct Node {
+    ASTNodeType type;
+    int line, column;
+    Node(ASTNodeType type, int line, int column) : type(type), line(line), column(column) {}
+    virtual ~Node() = default;
+};
+using NodePtr = std::unique_ptr<Node>;
+
+struct Program : Node {
+    std::shared_ptr<Source> source;
+    // Source::intern's strings, which the old Source kept itself.
+    std::shared_ptr<std::deque<std::string>> owned;
+    std::vector<NodePtr> statements;
+    Program() : Node(ASTNodeType::Program, 0, 0) {}
+};
+
+struct Load : Node {
+    std::string_view id, path;
+    Load(std::string_view id, std::string_view path, int line, int col)
+        : Node(ASTNodeType::Load, line, col), id(id), path(path) {}
+};
+
+struct Set : Node {
+    int amount;
+    std::string_view unit;
+    Set(int amount, std::string_view unit, int line, int col)
+        : Node(ASTNodeType::Set, line, col), amount(amount), unit(unit) {}
+};
+
+struct Transform : Node {
+    std::string_view table, column;
+    int amount;
+    std::string_view unit;
+    Transform(std::string_view table, std::string_view column, int amount, std::string_view unit, int line, int col)
+        : Node(ASTNodeType::Transform, line, col), table(table), column(column), amount(amount), unit(unit) {}
+};
+
+struct Forecast : Node {
+    std::string_view table, column, model;
+    std::vector<std::pair<std::string_view, int>> params;
+    Forecast(std::string_view table, std::string_view column, std::string_view model,
+             std::vector<std::pair<std::string_view, int>> params, int line, int col)
+        : Node(ASTNodeType::Forecast, line, col), table(table), column(column), model(model),
+          params(std::move(params)) {}
+};
+
+struct Select : Node {
+    std::string_view table, column;
+    std::optional<std::string_view> op, dateExpr;
+    Select(std::string_view table, std::string_view column, std::optional<std::string_view> op,
+           std::optional<std::string_view> dateExpr, int line, int col)
+        : Node(ASTNodeType::Select, line, col), table(table), column(column), op(op), dateExpr(dateExpr) {}
+};
+
+struct Plot : Node {
+    std::string_view function;
+    std::vector<std::pair<std::string_view, std::string_view>> args;
+    Plot(std::string_view function, std::vector<std::pair<std::string_view, std::string_view>> args, int line, int col)
+        : Node(ASTNodeType::Plot, line, col), function(function), args(std::move(args)) {}
+};
+
+struct Export : Node {
+    std::string_view table;
+    std::optional<std::string_view> column;
+    std::string_view target;
+    Export(std::string_view table, std::optional<std::string_view> column, std::string_view target, int line, int col)
+        : Node(ASTNodeType::Export, line, col), table(table), column(column), target(target) {}
+};
+
+struct Loop : Node {
+    std::string_view var;
+    int from, to;
+    std::vector<NodePtr> body;
+    Loop(std::string_view var, int from, int to, std::vector<NodePtr> body, int line, int col)
+        : Node(ASTNodeType::Loop, line, col), var(var), from(from), to(to), body(std::move(body)) {}
+};
+
+class Parser {
+public:
+    Parser(const std::vector<Token>& tokens, std::shared_ptr<Source> source) : tokens(tokens), source(source) {}
+
+    std::unique_ptr<Program> parse() {
+        program = std::make_unique<Program>();
+        program->source = source;
+        program->owned = std::make_shared<std::deque<std::string>>();
+        while (!isAtEnd()) program->statements.push_back(parseStatement());
+        return std::move(program);
+    }
+
+private:
+    const std::vector<Token>& tokens;
+    std::shared_ptr<Source> source;
+    std::unique_ptr<Program> program;
+    size_t current = 0;
+
+    static int toInt(std::string_view text) { return std::stoi(std::string(text)); }
+
+    const Token& peek() const { return tokens[current]; }
+    const Token& previous() const { return tokens[current - 1]; }
+    bool isAtEnd() const { return peek().type == TokenType::END_OF_FILE; }
+    bool check(TokenType type) const { return !isAtEnd() && peek().type == type; }
+    const Token& advance() { if (!isAtEnd()) current++; return previous(); }
+    bool match(TokenType type) { return check(type) ? (advance(), true) : false; }
+
+    void expect(TokenType type, const std::string& errorMessage) {
+        if (!match(type)) throw std::runtime_error("Expected " + errorMessage);
+    }
+
+    std::pair<std::string_view, std::optional<std::string_view>> parseTableAndColumn() {
+        expect(TokenType::ID, "table name");
+        std::string_view table = previous().value;
+        std::optional<std::string_view> column;
+        if (match(TokenType::DOT)) {
+            expect(TokenType::ID, "column name after '.'");
+            column = previous().value;
+        }
+        return {table, column};
+    }
+
+    std::pair<int, std::string_view> parseTimeInterval() {
+        expect(TokenType::TIME_UNIT, "time interval ");
+        std::string_view value = previous().value;
+        size_t i = 0;
+        while (i < value.size() && std::isdigit(static_cast<unsigned char>(value[i]))) ++i;
+        return {toInt(value.substr(0, i)), value.substr(i)};
+    }
+
+    NodePtr parseStatement() {
+        if (match(TokenType::LOAD)) {
+            Token id = advance();
+            expect(TokenType::FROM, "'FROM'");
+            Token path = advance();
+            return std::make_unique<Load>(id.value, path.value, id.line, id.column);
+        }
+        if (match(TokenType::SET)) {
+            expect(TokenType::WINDOW, "'WINDOW'");
+            expect(TokenType::EQUAL, "'='");
+            auto [amount, unit] = parseTimeInterval();
+            return std::make_unique<Set>(amount, unit, peek().line, peek().column);
+        }
+        if (match(TokenType::TREND)) {
+            expect(TokenType::LPAREN, "'('");
+            auto [table, column] = parseTableAndColumn();
+            expect(TokenType::RPAREN, "')'");
+            expect(TokenType::ARROW, "'->'");
+            expect(TokenType::ID, "'forecast_next'");
+            expect(TokenType::LPAREN, "'('");
+            auto [amount, unit] = parseTimeInterval();
+            expect(TokenType::RPAREN, "')'");
+            return std::make_unique<Transform>(table, column.value_or(""), amount, unit, peek().line, peek().column);
+        }
+        if (match(TokenType::FORECAST)) {
+            auto [table, column] = parseTableAndColumn();
+            expect(TokenType::USING, "'USING'");
+            Token model = advance();
+            expect(TokenType::LPAREN, "'('");
+            std::vector<std::pair<std::string_view, int>> params;
+            while (check(TokenType::ID)) {
+                std::string_view key = advance().value;
+                expect(TokenType::EQUAL, "'='");
+                params.emplace_back(key, toInt(advance().value));
+                if (!match(TokenType::COMMA)) break;
+            }
+            expect(TokenType::RPAREN, "')'");
+            return std::make_unique<Forecast>(table, column.value_or(""), model.value, std::move(params), model.line,
+                                              model.column);
+        }
+        if (match(TokenType::SELECT)) {
+            auto [table, column] = parseTableAndColumn();
+            std::optional<std::string_view> op, date;
+            if (match(TokenType::WHERE)) {
+                expect(TokenType::DATE, "'DATE'");
+                op = advance().value;
+                date = advance().value;
+            }
+            return std::make_unique<Select>(table, column.value_or(""), op, date, peek().line, peek().column);
+        }
+        if (match(TokenType::PLOT)) return parsePlot();
+        if (match(TokenType::EXPORT)) {
+            auto [table, column] = parseTableAndColumn();
+            expect(TokenType::TO, "'TO'");
+            Token target = advance();
+            return std::make_unique<Export>(table, column, target.value, static_cast<int>(table.length()),
+                                            target.column);
+        }
+        if (match(TokenType::FOR)) {
+            expect(TokenType::ID, "loop variable");
+            Token var = previous();
+            expect(TokenType::IN, "'IN'");
+            Token from = advance();
+            expect(TokenType::TO, "'TO'");
+            Token to = advance();
+            expect(TokenType::LBRACE, "'{'");
+            std::vector<NodePtr> body;
+            while (!check(TokenType::RBRACE) && !isAtEnd()) body.push_back(parseStatement());
+            expect(TokenType::RBRACE, "'}'");
+            return std::make_unique<Loop>(var.value, toInt(from.value), toInt(to.value), std::move(body), var.line,
+                                          var.column);
+        }
+        throw std::runtime_error("legacy parser: unsupported statement");
+    }
+
+    NodePtr parsePlot() {
+        Token plotType = advance();
+        expect(TokenType::LPAREN, "'('");
+        std::vector<std::pair<std::string_view, std::string_view>> args;
+        while (!check(TokenType::RPAREN)) {
+            expect(TokenType::ID, "parameter key");
+            std::string_view key = previous().value;
+            expect(TokenType::EQUAL, "'='");
+            std::string_view value;
+            if (check(TokenType::LBRACKET)) {
+                int depth = 0;
+                std::ostringstream buffer;
+                while (!isAtEnd()) {
+                    Token t = advance();
+                    if (t.type == TokenType::LBRACKET) depth++;
+                    if (t.type == TokenType::RBRACKET) depth--;
+                    buffer << t.value;
+                    if (depth == 0) break;
+                }
+                program->owned->push_back(buffer.str());
+                value = program->owned->back();
+            } else {
+                value = advance().value;
+            }
+            args.emplace_back(key, value);
+            if (!check(TokenType::RPAREN)) expect(TokenType::COMMA, "',' or ')'");
+        }
+        expect(TokenType::RPAREN, "')'");
+        return std::make_unique<Plot>(plotType.value, std::move(args), plotType.line, plotType.column);
+    }
+};
+
+} // namespace legacy
+
+// The DFA lexer with owned token values, as tokenize() was before they
+// became views: the reference for allocations per token.
+std::vector<OwnedToken> ownedTokenize(Lexer& lexer) {
+    std::vector<OwnedToken> tokens;
+    do {
+        Token token = lexer.next();
+        std::string value(token.value);
+        tokens.emplace_back(token.type, value, token.line, token.column);
+    } while (tokens.back().type != TokenType::END_OF_FILE);
+    return tokens;
+}
+
+template <typename A, typename B>
+bool sameTokens(const std::vector<A>& a, const std::vector<B>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].type != b[i].type || a[i].value != b[i].value ||
+            a[i].line != b[i].line || a[i].column != b[i].column)
+            return false;
+    }
+    return true;
+}
+
+template <typename F>
+double secondsFor(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, size_t bytes, size_t tokens, double seconds) {
+    std::cout << name << ": " << bytes << " bytes, " << tokens << " tokens, "
+              << seconds * 1000 << " ms, " << bytes / seconds / (1024 * 1024) << " MB/s\n";
+}
+
+// Peak resident set size of the process so far, in KB (0 if unknown).
+long peakRssKb() {
+#ifndef _WIN32
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+int benchLexer(double megabytes) {
+    // The regex tokenizer is quadratic, so it only gets a small input.
+    std::string small = makeScript(4 * 1024);
+    std::string large = makeScript(static_cast<size_t>(megabytes * 1024 * 1024));
+
+    std::vector<OwnedToken> expected;
+    std::vector<Token> actual;
+    double legacySeconds = secondsFor([&] { expected = legacyTokenize(small); });
+    Lexer smallLexer(small);
+    actual = smallLexer.tokenize();
+    if (!sameTokens(expected, actual)) {
+        std::cerr << "Token streams differ between the regex and the DFA lexer\n";
+        return 1;
+    }
+    report("regex lexer  ", small.size(), expected.size(), legacySeconds);
+
+    size_t before = allocationCount;
+    Lexer ownedLexer(large);
+    std::vector<OwnedToken> owned;
+    double ownedSeconds = secondsFor([&] { owned = ownedTokenize(ownedLexer); });
+    size_t ownedAllocations = allocationCount - before;
+    report("owned lexer  ", large.size(), owned.size(), ownedSeconds);
+
+    before = allocationCount;
+    Lexer lexer(large);
+    std::vector<Token> tokens;
+    double dfaSeconds = secondsFor([&] { tokens = lexer.tokenize(); });
+    size_t lexAllocations = allocationCount - before;
+    report("DFA lexer    ", large.size(), tokens.size(), dfaSeconds);
+    if (!sameTokens(owned, tokens)) {
+        std::cerr << "Owned and viewed token streams differ\n";
+        return 1;
+    }
+
+    MemoryReader reader(large);
+    Lexer streamLexer(reader);
+    size_t streamed = 0;
+    double streamSeconds = secondsFor([&] {
+        while (streamLexer.next().type != TokenType::END_OF_FILE) ++streamed;
+    });
+    report("stream lexer ", large.size(), streamed + 1, streamSeconds);
+
+    before = allocationCount;
+    Parser parser(tokens, lexer.getSource());
+    auto program = parser.parse();
+    size_t parseAllocations = allocationCount - before;
+
+    std::cout << "allocations per token: owned lex " << double(ownedAllocations) / owned.size()
+              << ", lex " << double(lexAllocations) / tokens.size()
+              << ", parse " << double(parseAllocations) / tokens.size()
+              << ", total " << double(lexAllocations + parseAllocations) / tokens.size() << "\n";
+    return 0;
+}
+
+// The statement types of a tree, depth first, loop bodies included.
+void statementTypes(const ArenaVector<ASTNodePtr>& statements, std::vector<ASTNodeType>& out) {
+    for (const ASTNode* node : statements) {
+        out.push_back(node->type);
+        if (node->type == ASTNodeType::Loop) statementTypes(static_cast<const LoopStmtNode*>(node)->body, out);
+    }
+}
+
+void statementTypes(const std::vector<legacy::NodePtr>& statements, std::vector<ASTNodeType>& out) {
+    for (const auto& node : statements) {
+        out.push_back(node->type);
+        if (node->type == ASTNodeType::Loop) statementTypes(static_cast<const legacy::Loop&>(*node).body, out);
+    }
+}
+
+// Both parsers build the same statements from a small script.
+bool sameTrees() {
+    std::string script = makeScript(64 * 1024);
+    Lexer lexer(script);
+    std::vector<Token> tokens = lexer.tokenize();
+    std::vector<ASTNodeType> expected, actual;
+    statementTypes(legacy::Parser(tokens, lexer.getSource()).parse()->statements, expected);
+    statementTypes(Parser(tokens, lexer.getSource()).parse()->statements, actual);
+    return expected == actual;
+}
+
+// Parse + destroy of one tree; ast-legacy runs the unique_ptr tree. Peak RSS
+// is per process, so each tree gets a run of its own.
+template <typename TreeParser>
+int benchAst(const char* name, double megabytes) {
+    if (!sameTrees()) {
+        std::cerr << "The arena and the unique_ptr parser build different trees\n";
+        return 1;
+    }
+    std::string script = makeScript(static_cast<size_t>(megabytes * 1024 * 1024));
+    Lexer lexer(script);
+    std::vector<Token> tokens = lexer.tokenize();
+    long rssBefore = peakRssKb();
+
+    size_t statements = 0;
+    size_t before = allocationCount;
+    double parseSeconds = 0, destroySeconds = 0;
+    {
+        TreeParser parser(tokens, lexer.getSource());
+        decltype(parser.parse()) program;
+        parseSeconds = secondsFor([&] { program = parser.parse(); });
+        statements = program->statements.size();
+        destroySeconds = secondsFor([&] { program.reset(); });
+    }
+
+    std::cout << name << ": " << statements << " statements, " << allocationCount - before
+              << " allocations, parse " << parseSeconds * 1000 << " ms, destroy " << destroySeconds * 1000
+              << " ms, peak RSS +" << peakRssKb() - rssBefore << " KB\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "lex";
+    double megabytes = argc > 2 ? std::atof(argv[2]) : 8;
+    if (mode == "ast") return benchAst<Parser>("ast", megabytes);
+    if (mode == "ast-legacy") return benchAst<legacy::Parser>("ast-legacy", megabytes);
+    return benchLexer(megabytes);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Bump allocator for one parse. Memory is handed out from large chunks and
+// only released, all at once, when the arena is destroyed. Destructors of
+// objects made in the arena are never run, so they may only own memory that
+// also comes from the arena (ArenaVector, copy()).
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        while (head) {
+            Chunk* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+
+    void* allocate(size_t size, size_t align) {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(cursor) + align - 1) & ~std::uintptr_t(align - 1);
+        if (!cursor || p + size > reinterpret_cast<std::uintptr_t>(end)) {
+            grow(size + align);
+            p = (reinterpret_cast<std::uintptr_t>(cursor) + align - 1) & ~std::uintptr_t(align - 1);
+        }
+        cursor = reinterpret_cast<char*>(p + size);
+        return reinterpret_cast<void*>(p);
+    }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    std::string_view copy(std::string_view text) {
+        char* data = static_cast<char*>(allocate(text.size(), 1));
+        std::memcpy(data, text.data(), text.size());
+        return std::string_view(data, text.size());
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+    };
+
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    Chunk* head = nullptr;
+    char* cursor = nullptr;
+    char* end = nullptr;
+
+    void grow(size_t atLeast) {
+        size_t size = sizeof(Chunk) + (atLeast > chunkSize ? atLeast : chunkSize);
+        Chunk* chunk = static_cast<Chunk*>(::operator new(size));
+        chunk->next = head;
+        head = chunk;
+        cursor = reinterpret_cast<char*>(chunk + 1);
+        end = reinterpret_cast<char*>(chunk) + size;
+    }
+};
+
+// Standard allocator over an Arena; deallocation is a no-op.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template <typename U> friend class ArenaAllocator;
+    Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -1,6 +1,8 @@
 #pragma once
+#include "arena.h"
+#include "source.h"
 #include <string>
-#include <vector>
+#include <string_view>
 #include <memory>
 #include <optional>
 
@@ -16,44 +18,49 @@ enum class CleanActionType {
 };
 
 
+// Statement nodes live in their ProgramNode's arena and are never destroyed
+// one by one; `type` tells which node struct an ASTNode is.
 struct ASTNode {
     ASTNodeType type;
     int line;
     int column;
     ASTNode(ASTNodeType type, int line, int column)
         : type(type), line(line), column(column) {}
-    virtual ~ASTNode() = default;
 };
 
-using ASTNodePtr = std::unique_ptr<ASTNode>;
+using ASTNodePtr = ASTNode*;
 
+// The root owns the arena holding every other node and the Source that the
+// string_views in the tree point into. Destroying it frees the whole tree.
 struct ProgramNode : public ASTNode {
-    std::vector<ASTNodePtr> statements;
-    ProgramNode() : ASTNode(ASTNodeType::Program, 0, 0) {}
+    std::shared_ptr<Source> source;
+    Arena arena;
+    ArenaVector<ASTNodePtr> statements;
+    ProgramNode() : ASTNode(ASTNodeType::Program, 0, 0), statements(ArenaAllocator<ASTNodePtr>(arena)) {}
 };
 
 struct LoadStmtNode : public ASTNode {
-    std::string id;
-    std::string path;
-    LoadStmtNode(const std::string& id, const std::string& path, int line, int col)
+    std::string_view id;
+    std::string_view path;
+    LoadStmtNode(std::string_view id, std::string_view path, int line, int col)
         : ASTNode(ASTNodeType::Load, line, col), id(id), path(path) {}
 };
 
 struct SetStmtNode : public ASTNode {
     int amount;
-    std::string unit;
-    SetStmtNode(int amount, const std::string& unit, int line, int col)
+    std::string_view unit;
+    SetStmtNode(int amount, std::string_view unit, int line, int col)
         : ASTNode(ASTNodeType::Set, line, col), amount(amount), unit(unit) {}
 };
 
 struct TransformStmtNode : public ASTNode {
-    std::string table;
-    std::string column;
+    std::string_view table;
+    std::string_view column;
     int intervalAmount;
-    std::string intervalUnit;
+    std::string_view intervalUnit;
 
-    TransformStmtNode(const std::string& table, const std::string& column,
-                      int amt, const std::string& unit,
+    TransformStmtNode(std::string_view table, std::string_view column,
+                      int amt, std::string_view unit,
                       int line, int col)
         : ASTNode(ASTNodeType::Transform, line, col),
           table(table), column(column),
@@ -62,37 +69,37 @@ struct TransformStmtNode : public ASTNode {
 
 
 struct ForecastStmtNode : public ASTNode {
-    std::string table;
-    std::string column;
-    std::string model;
-    std::vector<std::pair<std::string, int>> params;
-
-    ForecastStmtNode(const std::string& table, const std::string& column,
-                        const std::string& model,
-                        const std::vector<std::pair<std::string, int>>& params,
+    std::string_view table;
+    std::string_view column;
+    std::string_view model;
+    ArenaVector<std::pair<std::string_view, int>> params;
+
+    ForecastStmtNode(std::string_view table, std::string_view column,
+                        std::string_view model,
+                        ArenaVector<std::pair<std::string_view, int>> params,
                         int line, int col)
         : ASTNode(ASTNodeType::Forecast, line, col),
-            table(table), column(column), model(model), params(params) {}
+            table(table), column(column), model(model), params(std::move(params)) {}
 };
     
 
 struct StreamStmtNode : public ASTNode {
-    std::string id;
-    std::string path;
-    StreamStmtNode(const std::string& id, const std::string& path, int line, int col)
+    std::string_view id;
+    std::string_view path;
+    StreamStmtNode(std::string_view id, std::string_view path, int line, int col)
         : ASTNode(ASTNodeType::Stream, line, col), id(id), path(path) {}
 };
 
 struct SelectStmtNode : public ASTNode {
-    std::string table;
-    std::string column;
-    std::optional<std::string> op;
-    std::optional<std::string> dateExpr;
-
-    SelectStmtNode(const std::string& table,
-                   const std::string& column,
-                   std::optional<std::string> op,
-                   std::optional<std::string> dateExpr,
+    std::string_view table;
+    std::string_view column;
+    std::optional<std::string_view> op;
+    std::optional<std::string_view> dateExpr;
+
+    SelectStmtNode(std::string_view table,
+                   std::string_view column,
+                   std::optional<std::string_view> op,
+                   std::optional<std::string_view> dateExpr,
                    int line, int col)
         : ASTNode(ASTNodeType::Select, line, col),
           table(table), column(column), op(op), dateExpr(dateExpr) {}
@@ -100,21 +107,21 @@ struct SelectStmtNode : public ASTNode {
 
 
 struct PlotStmtNode : public ASTNode {
-    std::string function;
-    std::vector<std::pair<std::string, std::string>> args;
-    PlotStmtNode(const std::string& fn,
-        const std::vector<std::pair<std::string, std::string>>& args,
-        int line, int col): ASTNode(ASTNodeType::Plot, line, col), function(fn), args(args) {}
+    std::string_view function;
+    ArenaVector<std::pair<std::string_view, std::string_view>> args;
+    PlotStmtNode(std::string_view fn,
+        ArenaVector<std::pair<std::string_view, std::string_view>> args,
+        int line, int col): ASTNode(ASTNodeType::Plot, line, col), function(fn), args(std::move(args)) {}
 };
 
 struct ExportStmtNode : public ASTNode {
-    std::string table;
-    std::optional<std::string> column; 
-    std::string target;
+    std::string_view table;
+    std::optional<std::string_view> column; 
+    std::string_view target;
 
-    ExportStmtNode(const std::string& table,
-                   std::optional<std::string> column,
-                   const std::string& target,
+    ExportStmtNode(std::string_view table,
+                   std::optional<std::string_view> column,
+                   std::string_view target,
                    int line, int col)
         : ASTNode(ASTNodeType::Export, line, col),
           table(table), column(std::move(column)), target(target) {}
@@ -123,26 +130,26 @@ struct ExportStmtNode : public ASTNode {
 
 
 struct LoopStmtNode : public ASTNode {
-    std::string var;
+    std::string_view var;
     int from, to;
-    std::vector<ASTNodePtr> body;
-    LoopStmtNode(const std::string& var,
+    ArenaVector<ASTNodePtr> body;
+    LoopStmtNode(std::string_view var,
         int from, int to,
-        std::vector<ASTNodePtr> body,
+        ArenaVector<ASTNodePtr> body,
         int line, int col): ASTNode(ASTNodeType::Loop, line, col), var(var), from(from), to(to), body(std::move(body)) {}
 
 };
 
 struct CleanStmtNode : public ASTNode {
     CleanActionType action;
-    std::string targetValue;  
-    std::string column;       
-    std::string replaceWith;  
+    std::string_view targetValue;  
+    std::string_view column;       
+    std::string_view replaceWith;  
 
     CleanStmtNode(CleanActionType action,
-                  const std::string& targetValue,
-                  const std::string& column,
-                  const std::string& replaceWith,
+                  std::string_view targetValue,
+                  std::string_view column,
+                  std::string_view replaceWith,
                   int line, int col)
                   : ASTNode(ASTNodeType::Clean, line, col),
           action(action),
@@ -150,3 +157,23 @@ struct CleanStmtNode : public ASTNode {
           column(column),
           replaceWith(replaceWith) {}
 };
+
+// Calls visitor with node cast to its concrete type, chosen from node->type.
+// Types without a node struct of their own are passed as a plain ASTNode.
+template <typename Visitor>
+decltype(auto) visitNode(const ASTNode* node, Visitor&& visitor) {
+    switch (node->type) {
+        case ASTNodeType::Program: return visitor(static_cast<const ProgramNode&>(*node));
+        case ASTNodeType::Load: return visitor(static_cast<const LoadStmtNode&>(*node));
+        case ASTNodeType::Set: return visitor(static_cast<const SetStmtNode&>(*node));
+        case ASTNodeType::Transform: return visitor(static_cast<const TransformStmtNode&>(*node));
+        case ASTNodeType::Forecast: return visitor(static_cast<const ForecastStmtNode&>(*node));
+        case ASTNodeType::Stream: return visitor(static_cast<const StreamStmtNode&>(*node));
+        case ASTNodeType::Select: return visitor(static_cast<const SelectStmtNode&>(*node));
+        case ASTNodeType::Plot: return visitor(static_cast<const PlotStmtNode&>(*node));
+        case ASTNodeType::Export: return visitor(static_cast<const ExportStmtNode&>(*node));
+        case ASTNodeType::Loop: return visitor(static_cast<const LoopStmtNode&>(*node));
+        case ASTNodeType::Clean: return visitor(static_cast<const CleanStmtNode&>(*node));
+        default: return visitor(*node);
+    }
+}
@@ -1,4 +1,11 @@
-#include "third_party/nlohmann/json.hpp"
-#include "../include/ast.h"
-using json = nlohmann::json;
-json astToJson(const ASTNode* node);
\ No newline at end of file
+#pragma once
+#include "ast.h"
+#include <ostream>
+#include <string>
+
+// Serializes the tree as compact JSON with object keys in sorted order, the
+// same bytes nlohmann::json::dump() produced for it. Strings that are not
+// valid UTF-8 throw std::runtime_error.
+void astToJson(const ASTNode* node, std::string& out);
+void astToJson(const ASTNode* node, std::ostream& out);
+std::string astToJson(const ASTNode* node);
@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <string_view>
+#ifndef _WIN32
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#endif
+
+// Where a streaming Lexer pulls program text from.
+class ChunkReader {
+public:
+    virtual ~ChunkReader() = default;
+    // Copies up to size bytes into buffer. Returns 0 only at end of input.
+    virtual size_t read(char* buffer, size_t size) = 0;
+};
+
+class IstreamReader : public ChunkReader {
+public:
+    explicit IstreamReader(std::istream& in) : in(in) {}
+
+    size_t read(char* buffer, size_t size) override {
+        in.read(buffer, static_cast<std::streamsize>(size));
+        return static_cast<size_t>(in.gcount());
+    }
+
+private:
+    std::istream& in;
+};
+
+// Reads from memory that is already mapped, e.g. an mmap window.
+class MemoryReader : public ChunkReader {
+public:
+    explicit MemoryReader(std::string_view data) : data(data) {}
+
+    size_t read(char* buffer, size_t size) override {
+        size_t n = std::min(size, data.size());
+        std::memcpy(buffer, data.data(), n);
+        data.remove_prefix(n);
+        return n;
+    }
+
+private:
+    std::string_view data;
+};
+
+#ifndef _WIN32
+class FdReader : public ChunkReader {
+public:
+    explicit FdReader(int fd) : fd(fd) {}
+
+    size_t read(char* buffer, size_t size) override {
+        while (true) {
+            ssize_t n = ::read(fd, buffer, size);
+            if (n >= 0) return static_cast<size_t>(n);
+            if (errno != EINTR) throw std::runtime_error("read failed on file descriptor " + std::to_string(fd));
+        }
+    }
+
+private:
+    int fd;
+};
+#endif
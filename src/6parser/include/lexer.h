@@ -1,27 +1,41 @@
 #pragma once
 #include "token.h"
+#include "source.h"
+#include "chunk_reader.h"
+#include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
-#include <utility>
 
 class Lexer {
 public:
     explicit Lexer(const std::string& input);
+    explicit Lexer(std::shared_ptr<Source> source);
+    // Streaming mode: the program is pulled from reader chunkSize bytes at a
+    // time, and only the unread part of the current token is kept in memory.
+    explicit Lexer(ChunkReader& reader, size_t chunkSize = 64 * 1024);
+
+    // Returns the next token, END_OF_FILE once the input is exhausted. In
+    // streaming mode the token's value is only valid until the next call.
+    Token next();
+    // Token values point into getSource(); keep the lexer or the source alive
+    // for as long as the tokens are used. Not available in streaming mode.
     std::vector<Token> tokenize();
     const std::vector<Token>& getInvalidTokens() const;
+    const std::shared_ptr<Source>& getSource() const;
 
 private:
-    std::string input;
+    std::shared_ptr<Source> source;
+    ChunkReader* reader = nullptr;
+    size_t chunkSize = 0;
+    std::string window;
+    std::string_view input;
     size_t pos = 0;
     int line = 1;
     int column = 1;
 
     std::vector<Token> invalid_tokens;
 
-    std::vector<std::pair<TokenType, std::string>> tokenPatterns;
-    std::unordered_map<std::string, TokenType> keywords;
-
-    void initTokenPatterns();
-    void updatePosition(const std::string& value);
+    size_t scanToken(TokenType& type, bool& reachedEnd) const;
+    bool refill();
+    void updatePosition(size_t length);
 };
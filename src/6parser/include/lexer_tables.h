@@ -0,0 +1,420 @@
+#pragma once
+// Generated by tools/lexgen.cpp from token_patterns.h. Do not edit.
+// Minimal longest-match DFA over byte equivalence classes. State 0 is the
+// dead state; lexerAccept gives the token a state accepts, or INVALID.
+#include "token.h"
+#include <cstdint>
+
+inline constexpr int lexerStateCount = 192;
+inline constexpr int lexerClassCount = 45;
+inline constexpr std::uint8_t lexerDeadState = 0;
+inline constexpr std::uint8_t lexerStartState = 1;
+
+inline constexpr std::uint8_t lexerByteClass[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  2,  3,  0,  0,  0,  0,  0,  4,  5,  0,  0,  6,  7,  8,  0,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  0,  0, 10, 11, 12,  0,
+     0, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 22, 23, 24, 25, 26,
+    27, 22, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37,  0, 38,  0, 39,
+     0, 13, 14, 15, 40, 17, 18, 19, 41, 21, 22, 22, 23, 42, 25, 26,
+    27, 22, 28, 29, 30, 31, 32, 33, 34, 35, 36, 43,  0, 44,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+inline constexpr std::uint8_t lexerTransitions[lexerStateCount][lexerClassCount] = {
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 15, 19, 20, 15, 21, 22, 15, 15, 23, 24, 25, 26, 27, 15, 28, 15, 15, 15, 29, 30, 15, 16, 19, 22, 31, 32},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 33,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  3,  0,  3, 34,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 35,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0, 36,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 37, 37, 37,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 38,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 39,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 41, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 42, 15, 15, 43, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 44, 15, 15, 15, 45, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 46, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 47, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 48, 15, 49, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 50, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 51, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 52, 15, 15, 15, 15, 53, 15, 15, 54, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 55, 15, 15, 15, 56, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 57, 15, 15, 15, 15, 58, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 59, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 60, 15, 61, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 62, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 63, 15, 15, 15, 15, 15, 15, 15, 15, 64, 15, 65, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 66, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 67, 68, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 67, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 69,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 70, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 71, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 72, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 73, 74, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 75, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 76, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 77, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 78, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 79, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 80, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 81, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 82, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 83, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 84, 15, 15, 85, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 85, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 86, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 87, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 88, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 89, 15, 15, 90, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 89,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 91, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 92, 15, 15, 15, 15, 15, 15, 93, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 94, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 95, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 96, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 97, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 98, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 99, 15, 15, 15, 15,100, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 69,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,101, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,102, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,103, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15,103,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,104, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,105, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,106, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,107, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,108, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,109, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,110, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15,110,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,111, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,112, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15,113, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15,113, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,114, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15,114,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,115, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15,116, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,117, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,118, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,119, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,120, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,121, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,122, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,123, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,124, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15,125, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15,125, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,126, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,127, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,128, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15,129, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15,129, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15,130, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15,130, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,131, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,132, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,133, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,134, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15,135, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15,135, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,136, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,137, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15,138, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,139, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,140, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,141, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15,142, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15,143, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15,143, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,144, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,145, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,146, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15,147, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,148, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,149, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15,150, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15,150, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15,151, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,152, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,153, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,154,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,155, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0,156, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,157, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,158, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15,159, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,160, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,161, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,162, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,163, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,164, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15,165, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,166, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,167, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,168, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15,168,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,169, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,170, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,171, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,172, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,173, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,174, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,175, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,176, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15,177, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,178, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15,179, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,180, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15,181, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,182, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,183, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0,184, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,185, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,186, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,187, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,188, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15,188,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,189, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,190, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,191, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+    {  0,  0,  0,  0,  0,  0,  0,  0,  0, 15,  0,  0,  0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  0,  0, 15, 15, 15, 15,  0,  0},
+};
+
+inline constexpr TokenType lexerAccept[lexerStateCount] = {
+    TokenType::INVALID,
+    TokenType::INVALID,
+    TokenType::INVALID,
+    TokenType::INVALID,
+    TokenType::LPAREN,
+    TokenType::RPAREN,
+    TokenType::COMMA,
+    TokenType::INVALID,
+    TokenType::DOT,
+    TokenType::INT,
+    TokenType::LESS,
+    TokenType::EQUAL,
+    TokenType::GREATER,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::LBRACKET,
+    TokenType::RBRACKET,
+    TokenType::LBRACE,
+    TokenType::RBRACE,
+    TokenType::NOT_EQUAL,
+    TokenType::STRING,
+    TokenType::ARROW,
+    TokenType::INVALID,
+    TokenType::TIME_UNIT,
+    TokenType::LESS_EQUAL,
+    TokenType::EQUAL_EQUAL,
+    TokenType::GREATER_EQUAL,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::IN,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::TO,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::FLOAT,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::FOR,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::SET,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::DATE,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::FROM,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::LOAD,
+    TokenType::LSTM,
+    TokenType::MEAN,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::PLOT,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::WITH,
+    TokenType::ABOVE,
+    TokenType::ID,
+    TokenType::ARIMA,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::BELOW,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::TREND,
+    TokenType::USING,
+    TokenType::WHERE,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::EXPORT,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::MEDIAN,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::REMOVE,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::SELECT,
+    TokenType::STREAM,
+    TokenType::ID,
+    TokenType::WINDOW,
+    TokenType::ANALYZE,
+    TokenType::BARPLOT,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::MISSING,
+    TokenType::PROPHET,
+    TokenType::REPLACE,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::BASED_ON,
+    TokenType::FORECAST,
+    TokenType::ID,
+    TokenType::LINEPLOT,
+    TokenType::ID,
+    TokenType::TENDENCY,
+    TokenType::HISTOGRAM,
+    TokenType::ID,
+    TokenType::ID,
+    TokenType::SCATTERPLOT,
+};
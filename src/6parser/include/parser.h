@@ -1,28 +1,37 @@
 #pragma once
 #include "token.h"
 #include "ast.h"
+#include "source.h"
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 
 class Parser {
 public:
-    explicit Parser(const std::vector<Token>& tokens);
+    Parser(const std::vector<Token>& tokens, std::shared_ptr<Source> source);
     std::unique_ptr<ProgramNode> parse();
 
 private:
     const std::vector<Token>& tokens;
+    std::shared_ptr<Source> source;
+    Arena* arena = nullptr;  // arena of the ProgramNode being built
     size_t current = 0;
 
+    template <typename T, typename... Args>
+    ASTNodePtr make(Args&&... args) { return arena->make<T>(std::forward<Args>(args)...); }
+    template <typename T>
+    ArenaVector<T> makeVector() { return ArenaVector<T>(ArenaAllocator<T>(*arena)); }
+
     const Token& peek() const;
     const Token& previous() const;
     bool match(TokenType type);
     bool check(TokenType type) const;
     const Token& advance();
     bool isAtEnd() const;
-    void expect(TokenType type, const std::string& errorMessage);
+    void expect(TokenType type, std::string_view errorMessage);
     void synchronize();
-    std::pair<std::string, std::optional<std::string>> parseTableAndColumn();
+    std::pair<std::string_view, std::optional<std::string_view>> parseTableAndColumn();
     ASTNodePtr parseStatement();
 
     ASTNodePtr parseLoadStatement();
@@ -36,12 +45,12 @@ private:
     ASTNodePtr parseLoopStatement();
     ASTNodePtr parseCleanStatement();
 
-    std::pair<int, std::string> parseTimeInterval();
-    std::pair<std::string, std::string> parseIDEqualsValue();
-    std::vector<std::pair<std::string, int>> parseParams();
+    std::pair<int, std::string_view> parseTimeInterval();
+    std::pair<std::string_view, std::string_view> parseIDEqualsValue();
+    ArenaVector<std::pair<std::string_view, int>> parseParams();
     std::vector<std::vector<double>> parseListOfLists();
     std::vector<double> parseListOfNumbers();
-    std::vector<std::string> parseListOfStrings();
-    std::string parseColumn();
-    std::string parseValue();
+    std::vector<std::string_view> parseListOfStrings();
+    std::string_view parseColumn();
+    std::string_view parseValue();
 };
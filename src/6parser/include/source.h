@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Owns the text of one ChronoLang program. Token values and most AST strings
+// are string_views into it, so the lexer and the parsed ProgramNode share it
+// through a shared_ptr and it lives as long as either of them.
+class Source {
+public:
+    explicit Source(std::string text) : text(std::move(text)) {}
+
+    std::string_view view() const { return text; }
+
+private:
+    std::string text;
+};
@@ -1,5 +1,5 @@
 #pragma once
-#include <string>
+#include <string_view>
 //Token types and their distribution
 enum class TokenType {
     // Keywords
@@ -18,12 +18,14 @@ enum class TokenType {
     END_OF_FILE, INVALID
 };
 
+// value is a view into the Source the lexer was given; it is only valid
+// while that Source is alive.
 struct Token {
     TokenType type;
-    std::string value;
+    std::string_view value;
     int line;
     int column;
 
-    Token(TokenType type, const std::string& value, int line, int column)
+    Token(TokenType type, std::string_view value, int line, int column)
         : type(type), value(value), line(line), column(column) {}
 };
@@ -0,0 +1,47 @@
+#pragma once
+#include "token.h"
+#include <string_view>
+#include <utility>
+
+// Lexical grammar of ChronoLang.
+// Patterns are tried in this order and the first one that matches wins, so
+// TIME_UNIT must come before FLOAT and FLOAT before INT. An ID whose upper-cased
+// text is listed in keywordTable becomes that keyword.
+inline constexpr std::pair<TokenType, std::string_view> tokenPatterns[] = {
+    {TokenType::EQUAL_EQUAL, R"(==)"},
+    {TokenType::LESS_EQUAL, R"(<=)"},
+    {TokenType::GREATER_EQUAL, R"(>=)"},
+    {TokenType::NOT_EQUAL, R"(!=)"},
+    {TokenType::ARROW, R"(->)"},
+    {TokenType::EQUAL, R"(=)"},
+    {TokenType::LESS, R"(<)"},
+    {TokenType::GREATER, R"(>)"},
+    {TokenType::LBRACE, R"(\{)"},
+    {TokenType::RBRACE, R"(\})"},
+    {TokenType::LPAREN, R"(\()"},
+    {TokenType::RPAREN, R"(\))"},
+    {TokenType::LBRACKET, R"(\[)"},
+    {TokenType::RBRACKET, R"(\])"},
+    {TokenType::COMMA, R"(,)"},
+    {TokenType::DOT, R"(\.)"},
+    {TokenType::STRING, R"str("([^"\n]*)")str"},
+    {TokenType::TIME_UNIT, R"(\d+(d|h|m))"}, // e.g. 7d
+    {TokenType::FLOAT, R"(\d+\.\d+)"},       // e.g. 12.5
+    {TokenType::INT, R"(\d+)"},              // e.g. 12
+    {TokenType::ID, R"([A-Za-z_][A-Za-z0-9_]*)"}
+};
+
+inline constexpr std::pair<std::string_view, TokenType> keywordTable[] = {
+    {"LOAD", TokenType::LOAD}, {"FROM", TokenType::FROM}, {"SET", TokenType::SET},
+    {"WINDOW", TokenType::WINDOW}, {"TREND", TokenType::TREND}, {"FORECAST", TokenType::FORECAST},
+    {"USING", TokenType::USING}, {"STREAM", TokenType::STREAM}, {"SELECT", TokenType::SELECT},
+    {"WHERE", TokenType::WHERE}, {"DATE", TokenType::DATE}, {"PLOT", TokenType::PLOT},
+    {"EXPORT", TokenType::EXPORT}, {"TO", TokenType::TO}, {"FOR", TokenType::FOR},
+    {"IN", TokenType::IN}, {"REMOVE", TokenType::REMOVE}, {"MISSING", TokenType::MISSING},
+    {"REPLACE", TokenType::REPLACE}, {"WITH", TokenType::WITH}, {"ANALYZE", TokenType::ANALYZE},
+    {"BASED_ON", TokenType::BASED_ON}, {"BELOW", TokenType::BELOW}, {"ABOVE", TokenType::ABOVE},
+    {"MEAN", TokenType::MEAN}, {"MEDIAN", TokenType::MEDIAN}, {"TENDENCY", TokenType::TENDENCY},
+    {"ARIMA", TokenType::ARIMA}, {"PROPHET", TokenType::PROPHET}, {"LSTM", TokenType::LSTM},
+    {"LINEPLOT", TokenType::LINEPLOT}, {"HISTOGRAM", TokenType::HISTOGRAM},
+    {"SCATTERPLOT", TokenType::SCATTERPLOT}, {"BARPLOT", TokenType::BARPLOT}
+};
@@ -1,100 +1,95 @@
 #include "include/lexer.h"
-#include <regex>
+#include "include/lexer_tables.h"
 #include <cctype>
+#include <stdexcept>
 
-Lexer::Lexer(const std::string& input) : input(input) {
-    initTokenPatterns();
-}
+Lexer::Lexer(const std::string& input) : Lexer(std::make_shared<Source>(input)) {}
 
-void Lexer::initTokenPatterns() {
-    tokenPatterns = {
-        {TokenType::EQUAL_EQUAL, R"(==)"},
-        {TokenType::LESS_EQUAL, R"(<=)"},
-        {TokenType::GREATER_EQUAL, R"(>=)"},
-        {TokenType::NOT_EQUAL, R"(!=)"},
-        {TokenType::ARROW, R"(->)"},
-        {TokenType::EQUAL, R"(=)"},
-        {TokenType::LESS, R"(<)"},
-        {TokenType::GREATER, R"(>)"},
-        {TokenType::LBRACE, R"(\{)"},
-        {TokenType::RBRACE, R"(\})"},
-        {TokenType::LPAREN, R"(\()"},
-        {TokenType::RPAREN, R"(\))"},
-        {TokenType::LBRACKET, R"(\[)"},
-        {TokenType::RBRACKET, R"(\])"},
-        {TokenType::COMMA, R"(,)"},
-        {TokenType::DOT, R"(\.)"},
-        {TokenType::STRING, R"str("([^"\n]*)")str"},
-        {TokenType::TIME_UNIT, R"(\d+(d|h|m))"}, // e.g. 7d
-        {TokenType::FLOAT, R"(\d+\.\d+)"},       // e.g. 12.5
-        {TokenType::INT, R"(\d+)"},              // e.g. 12
-        {TokenType::ID, R"([A-Za-z_][A-Za-z0-9_]*)"}
-    };    
-
-    keywords = {
-        {"LOAD", TokenType::LOAD}, {"FROM", TokenType::FROM}, {"SET", TokenType::SET},
-        {"WINDOW", TokenType::WINDOW}, {"TREND", TokenType::TREND}, {"FORECAST", TokenType::FORECAST},
-        {"USING", TokenType::USING}, {"STREAM", TokenType::STREAM}, {"SELECT", TokenType::SELECT},
-        {"WHERE", TokenType::WHERE}, {"DATE", TokenType::DATE}, {"PLOT", TokenType::PLOT},
-        {"EXPORT", TokenType::EXPORT}, {"TO", TokenType::TO}, {"FOR", TokenType::FOR},
-        {"IN", TokenType::IN}, {"REMOVE", TokenType::REMOVE}, {"MISSING", TokenType::MISSING},
-        {"REPLACE", TokenType::REPLACE}, {"WITH", TokenType::WITH}, {"ANALYZE", TokenType::ANALYZE},
-        {"BASED_ON", TokenType::BASED_ON}, {"BELOW", TokenType::BELOW}, {"ABOVE", TokenType::ABOVE},
-        {"MEAN", TokenType::MEAN}, {"MEDIAN", TokenType::MEDIAN}, {"TENDENCY", TokenType::TENDENCY},
-        {"ARIMA", TokenType::ARIMA}, {"PROPHET", TokenType::PROPHET}, {"LSTM", TokenType::LSTM},
-        {"LINEPLOT", TokenType::LINEPLOT}, {"HISTOGRAM", TokenType::HISTOGRAM},
-        {"SCATTERPLOT", TokenType::SCATTERPLOT}, {"BARPLOT", TokenType::BARPLOT}
-    };
-}
+Lexer::Lexer(std::shared_ptr<Source> source) : source(std::move(source)), input(this->source->view()) {}
+
+Lexer::Lexer(ChunkReader& reader, size_t chunkSize) : reader(&reader), chunkSize(chunkSize) {}
 
 std::vector<Token> Lexer::tokenize() {
+    if (reader) throw std::logic_error("tokenize() needs an in-memory source; use next() when streaming");
+
     std::vector<Token> tokens;
-    std::smatch match;
+    do {
+        tokens.push_back(next());
+    } while (tokens.back().type != TokenType::END_OF_FILE);
+    return tokens;
+}
 
-    while (pos < input.size()) {
-        std::string remaining = input.substr(pos);
-        bool matched = false;
+// scanToken() runs the DFA generated from token_patterns.h (see
+// tools/lexgen.cpp), which recognises keywords too.
+Token Lexer::next() {
+    while (true) {
+        if (pos == input.size() && !refill()) return Token(TokenType::END_OF_FILE, "", line, column);
 
         // Skip whitespace manually
-        if (std::isspace(input[pos])) {
-            updatePosition(std::string(1, input[pos]));
+        if (std::isspace(static_cast<unsigned char>(input[pos]))) {
+            updatePosition(1);
             continue;
         }
 
-        for (const auto& [type, pattern] : tokenPatterns) {
-            std::regex regex("^" + pattern);
-            if (std::regex_search(remaining, match, regex)) {
-                std::string value = match[0];
-
-                TokenType finalType = type;
-                if (type == TokenType::ID) {
-                    std::string upper;
-                    for (char c : value) upper += std::toupper(c);
-                    if (keywords.count(upper)) {
-                        finalType = keywords[upper];
-                    }
-                }
-
-                tokens.emplace_back(finalType, value, line, column);
-                updatePosition(value);
-                matched = true;
-                break;
-            }
-        }
+        // A token that runs into the end of the window may continue in the
+        // next chunk, so it is scanned again once more input is available.
+        TokenType type;
+        bool reachedEnd;
+        size_t length = scanToken(type, reachedEnd);
+        while (reachedEnd && refill()) length = scanToken(type, reachedEnd);
 
-        if (!matched) {
+        if (length == 0) {
             // Skip invalid character silently
-            updatePosition(std::string(1, input[pos]));
+            updatePosition(1);
+            continue;
         }
+
+        Token token(type, input.substr(pos, length), line, column);
+        updatePosition(length);
+        return token;
     }
+}
 
-    tokens.emplace_back(TokenType::END_OF_FILE, "", line, column);
-    return tokens;
+// Drops everything before pos and appends the next chunk. The window thus
+// never holds more than the current token plus one chunk.
+bool Lexer::refill() {
+    if (!reader) return false;
+
+    window.erase(0, pos);
+    pos = 0;
+    size_t kept = window.size();
+    window.resize(kept + chunkSize);
+    size_t n = reader->read(&window[kept], chunkSize);
+    window.resize(kept + n);
+    input = window;
+    return n > 0;
 }
 
-void Lexer::updatePosition(const std::string& value) {
-    for (char c : value) {
-        if (c == '\n') {
+// Returns the length of the longest token starting at pos, or 0 if no
+// pattern matches. Ties were resolved by pattern order when the table was built.
+// reachedEnd is set when the DFA was still alive at the end of the input.
+size_t Lexer::scanToken(TokenType& type, bool& reachedEnd) const {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(input.data()) + pos;
+    const size_t left = input.size() - pos;
+
+    std::uint8_t state = lexerStartState;
+    size_t length = 0;
+    reachedEnd = false;
+    for (size_t i = 0; i < left; ++i) {
+        state = lexerTransitions[state][lexerByteClass[s[i]]];
+        if (state == lexerDeadState) return length;
+        if (lexerAccept[state] != TokenType::INVALID) {
+            type = lexerAccept[state];
+            length = i + 1;
+        }
+    }
+    reachedEnd = true;
+    return length;
+}
+
+void Lexer::updatePosition(size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (input[pos] == '\n') {
             line++;
             column = 1;
         } else {
@@ -104,6 +99,10 @@ void Lexer::updatePosition(const std::string& value) {
     }
 }
 
+const std::shared_ptr<Source>& Lexer::getSource() const {
+    return source;
+}
+
 const std::vector<Token>& Lexer::getInvalidTokens() const {
     return invalid_tokens; // Will always be empty in this version
 }
@@ -61,12 +61,11 @@ int main() {
         for (const auto& token : tokens) {
             std::cerr << "Token: "<< token.value << " Id: " << std::to_string(int(token.type)) << " line " << token.line << " collumn " <<  token.column << "\n";
         }
-        Parser parser(tokens);
+        Parser parser(tokens, lexer.getSource());
         auto ast = parser.parse();
         std::string result;
         try {
-            json j = astToJson(ast.get());
-            result = j.dump(); 
+            result = astToJson(ast.get());
         } catch (const std::exception& e) {
             result = std::string("{\"error\": \"") + e.what() + "\"}";
         }
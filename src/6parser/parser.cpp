@@ -1,11 +1,14 @@
 #include "include/parser.h"
 #include <stdexcept>
 #include <cstdlib>
-#include <sstream>
 
 // === Core Parsing===
 
-Parser::Parser(const std::vector<Token>& tokens) : tokens(tokens) {}
+Parser::Parser(const std::vector<Token>& tokens, std::shared_ptr<Source> source)
+    : tokens(tokens), source(std::move(source)) {}
+
+static int toInt(std::string_view text) { return std::stoi(std::string(text)); }
+static double toDouble(std::string_view text) { return std::stod(std::string(text)); }
 
 const Token& Parser::peek() const { return tokens[current]; }
 const Token& Parser::previous() const { return tokens[current - 1]; }
@@ -21,21 +24,26 @@ bool Parser::match(TokenType type) {
     return false;
 }
 
-void Parser::expect(TokenType type, const std::string& errorMessage) {
+void Parser::expect(TokenType type, std::string_view errorMessage) {
     if (!match(type)) {
-        throw std::runtime_error("Expected " + errorMessage + " at line " +
+        throw std::runtime_error("Expected " + std::string(errorMessage) + " at line " +
                                  std::to_string(peek().line) + ", column " +
                                  std::to_string(peek().column));
     }
 }
 
-std::string Parser::parseColumn() {
+std::string_view Parser::parseColumn() {
     expect(TokenType::ID, "table or column name");
-    std::string name = previous().value;
+    std::string_view name = previous().value;
 
     if (match(TokenType::DOT)) {
         expect(TokenType::ID, "column name after '.'");
-        name += "." + previous().value;
+        std::string_view column = previous().value;
+        // "table.column" written without spaces is already a slice of the source.
+        if (name.data() + name.size() + 1 == column.data())
+            name = std::string_view(name.data(), name.size() + 1 + column.size());
+        else
+            name = arena->copy(std::string(name) + "." + std::string(column));
     }
 
     return name;
@@ -43,7 +51,7 @@ std::string Parser::parseColumn() {
 
 
 
-std::string Parser::parseValue() {
+std::string_view Parser::parseValue() {
     if (check(TokenType::STRING) || check(TokenType::INT) || check(TokenType::FLOAT)) {
         return advance().value;
     }
@@ -53,16 +61,18 @@ std::string Parser::parseValue() {
 
 std::unique_ptr<ProgramNode> Parser::parse() {
     auto program = std::make_unique<ProgramNode>();
+    program->source = source;
+    arena = &program->arena;
     while (!isAtEnd()) {
         program->statements.push_back(parseStatement());
     }
     return program;
 }
 
-std::pair<std::string, std::optional<std::string>> Parser::parseTableAndColumn() {
+std::pair<std::string_view, std::optional<std::string_view>> Parser::parseTableAndColumn() {
     expect(TokenType::ID, "table name");
-    std::string table = previous().value;
-    std::optional<std::string> column;
+    std::string_view table = previous().value;
+    std::optional<std::string_view> column;
 
     if (match(TokenType::DOT)) {
         expect(TokenType::ID, "column name after '.'");
@@ -89,21 +99,21 @@ ASTNodePtr Parser::parseStatement() {
         return parseCleanStatement();
 
     throw std::runtime_error("Unexpected token at line " + std::to_string(peek().line) + ", column " +
-                             std::to_string(peek().column) + ": " + peek().value);
+                             std::to_string(peek().column) + ": " + std::string(peek().value));
 }
 
 ASTNodePtr Parser::parseLoadStatement() {
     Token id = advance();
     expect(TokenType::FROM, "'FROM'");
     Token path = advance();
-    return std::make_unique<LoadStmtNode>(id.value, path.value, id.line, id.column);
+    return make<LoadStmtNode>(id.value, path.value, id.line, id.column);
 }
 
 ASTNodePtr Parser::parseSetStatement() {
     expect(TokenType::WINDOW, "'WINDOW'");
     expect(TokenType::EQUAL, "'='");
     auto [amount, unit] = parseTimeInterval();
-    return std::make_unique<SetStmtNode>(amount, unit, peek().line, peek().column);
+    return make<SetStmtNode>(amount, unit, peek().line, peek().column);
 }
 
 ASTNodePtr Parser::parseTransformStatement() {
@@ -119,7 +129,7 @@ ASTNodePtr Parser::parseTransformStatement() {
     if (!column.has_value())
         throw std::runtime_error("TREND requires a table.column reference");
 
-    return std::make_unique<TransformStmtNode>(
+    return make<TransformStmtNode>(
         table, *column, amount, unit, peek().line, peek().column
     );
 }
@@ -135,8 +145,8 @@ ASTNodePtr Parser::parseForecastStatement() {
     if (!column.has_value())
         throw std::runtime_error("FORECAST requires a table.column reference");
 
-    return std::make_unique<ForecastStmtNode>(
-        table, *column, model.value, params, model.line, model.column
+    return make<ForecastStmtNode>(
+        table, *column, model.value, std::move(params), model.line, model.column
     );
 }
 
@@ -144,12 +154,12 @@ ASTNodePtr Parser::parseStreamStatement() {
     Token id = advance();
     expect(TokenType::FROM, "'FROM'");
     Token path = advance();
-    return std::make_unique<StreamStmtNode>(id.value, path.value, id.line, id.column);
+    return make<StreamStmtNode>(id.value, path.value, id.line, id.column);
 }
 
 ASTNodePtr Parser::parseSelectStatement() {
     auto [table, column] = parseTableAndColumn();
-    std::optional<std::string> op, date;
+    std::optional<std::string_view> op, date;
     if (match(TokenType::WHERE)) {
         expect(TokenType::DATE, "'DATE'");
         Token oper = advance();
@@ -161,7 +171,7 @@ ASTNodePtr Parser::parseSelectStatement() {
     if (!column.has_value())
         throw std::runtime_error("SELECT requires a table.column reference");
 
-    return std::make_unique<SelectStmtNode>(
+    return make<SelectStmtNode>(
         table, *column, op, date, peek().line, peek().column
     );
 }
@@ -170,19 +180,19 @@ ASTNodePtr Parser::parsePlotStatement() {
     Token plotType = advance();
     expect(TokenType::LPAREN, "'('");
 
-    std::vector<std::pair<std::string, std::string>> args;
+    auto args = makeVector<std::pair<std::string_view, std::string_view>>();
 
     while (!check(TokenType::RPAREN)) {
         expect(TokenType::ID, "parameter key");
-        std::string key = previous().value;
+        std::string_view key = previous().value;
         expect(TokenType::EQUAL, "'='");
 
-        std::string value;
+        std::string_view value;
         if (check(TokenType::STRING) || check(TokenType::INT) || check(TokenType::FLOAT)) {
             value = advance().value;
         } else if (check(TokenType::LBRACKET)) {
             int bracketCount = 0;
-            std::ostringstream buffer;
+            std::string buffer;
 
             while (!isAtEnd()) {
                 Token t = advance();
@@ -190,7 +200,7 @@ ASTNodePtr Parser::parsePlotStatement() {
                 if (t.type == TokenType::LBRACKET) bracketCount++;
                 if (t.type == TokenType::RBRACKET) bracketCount--;
 
-                buffer << t.value;
+                buffer += t.value;
 
                 if (bracketCount == 0) break;
             }
@@ -199,7 +209,7 @@ ASTNodePtr Parser::parsePlotStatement() {
                 throw std::runtime_error("Mismatched brackets in plot parameter value at line " + std::to_string(peek().line));
             }
 
-            value = buffer.str();
+            value = arena->copy(buffer);
         } else {
             throw std::runtime_error("Unexpected plot parameter value at line " + std::to_string(peek().line));
         }
@@ -213,14 +223,14 @@ ASTNodePtr Parser::parsePlotStatement() {
 
     expect(TokenType::RPAREN, "')'");
 
-    return std::make_unique<PlotStmtNode>(plotType.value, args, plotType.line, plotType.column);
+    return make<PlotStmtNode>(plotType.value, std::move(args), plotType.line, plotType.column);
 }
 
 
 ASTNodePtr Parser::parseExportStatement() {
     expect(TokenType::ID, "table or column name");
-    std::string table = previous().value;
-    std::optional<std::string> column;
+    std::string_view table = previous().value;
+    std::optional<std::string_view> column;
 
     if (match(TokenType::DOT)) {
         expect(TokenType::ID, "column name after '.'");
@@ -230,7 +240,7 @@ ASTNodePtr Parser::parseExportStatement() {
     expect(TokenType::TO, "'TO'");
     Token target = advance();
 
-    return std::make_unique<ExportStmtNode>(table, column, target.value, table.length(), target.column);
+    return make<ExportStmtNode>(table, column, target.value, table.length(), target.column);
 }
 
 
@@ -238,7 +248,7 @@ ASTNodePtr Parser::parseExportStatement() {
 ASTNodePtr Parser::parseLoopStatement() {
     expect(TokenType::ID, "loop variable");
     Token loopToken = previous();
-    std::string loopVar = loopToken.value;
+    std::string_view loopVar = loopToken.value;
 
     expect(TokenType::IN, "'IN'");
     Token start = advance();
@@ -246,17 +256,17 @@ ASTNodePtr Parser::parseLoopStatement() {
     Token end = advance();
     expect(TokenType::LBRACE, "'{'");
 
-    std::vector<ASTNodePtr> body;
+    auto body = makeVector<ASTNodePtr>();
     while (!check(TokenType::RBRACE) && !isAtEnd()) {
         body.push_back(parseStatement());
     }
 
     expect(TokenType::RBRACE, "'}'");
 
-    return std::make_unique<LoopStmtNode>(
+    return make<LoopStmtNode>(
         loopVar,
-        std::stoi(start.value),
-        std::stoi(end.value),
+        toInt(start.value),
+        toInt(end.value),
         std::move(body),
         loopToken.line,
         loopToken.column
@@ -272,8 +282,8 @@ ASTNodePtr Parser::parseCleanStatement() {
 
     if (isRemove) {
         expect(TokenType::FROM, "'FROM'");
-        std::string column = parseColumn();
-        return std::make_unique<CleanStmtNode>(
+        std::string_view column = parseColumn();
+        return make<CleanStmtNode>(
             CleanActionType::Remove,
             target.value,
             column,
@@ -283,10 +293,10 @@ ASTNodePtr Parser::parseCleanStatement() {
         );
     } else { 
         expect(TokenType::IN, "'IN'");
-        std::string column = parseColumn();
+        std::string_view column = parseColumn();
         expect(TokenType::WITH, "'WITH'");
-        std::string replacement = parseValue();
-        return std::make_unique<CleanStmtNode>(
+        std::string_view replacement = parseValue();
+        return make<CleanStmtNode>(
             CleanActionType::Replace,
             target.value,
             column,
@@ -298,10 +308,10 @@ ASTNodePtr Parser::parseCleanStatement() {
 }
 
 
-std::pair<int, std::string> Parser::parseTimeInterval() {
+std::pair<int, std::string_view> Parser::parseTimeInterval() {
     expect(TokenType::TIME_UNIT, "time interval ");
 
-    std::string value = previous().value;
+    std::string_view value = previous().value;
 
     size_t i = 0;
     while (i < value.size() && std::isdigit(value[i])) ++i;
@@ -311,34 +321,34 @@ std::pair<int, std::string> Parser::parseTimeInterval() {
             std::to_string(previous().line));
     }
 
-    int amount = std::stoi(value.substr(0, i));
-    std::string unit = value.substr(i);
+    int amount = toInt(value.substr(0, i));
+    std::string_view unit = value.substr(i);
 
     return { amount, unit };
 
 }
 
-std::pair<std::string, std::string> Parser::parseIDEqualsValue() {
+std::pair<std::string_view, std::string_view> Parser::parseIDEqualsValue() {
     expect(TokenType::ID, "parameter key");
-    std::string key = previous().value;
+    std::string_view key = previous().value;
 
     expect(TokenType::EQUAL, "'='");
 
-    std::string value = parseValue();
+    std::string_view value = parseValue();
 
     return { key, value };
 }
 
-std::vector<std::pair<std::string, int>> Parser::parseParams() {
-    std::vector<std::pair<std::string, int>> params;
+ArenaVector<std::pair<std::string_view, int>> Parser::parseParams() {
+    auto params = makeVector<std::pair<std::string_view, int>>();
 
     if (check(TokenType::ID)) {
         auto [key, val] = parseIDEqualsValue();
-        params.emplace_back(key, std::stoi(val));
+        params.emplace_back(key, toInt(val));
 
         while (match(TokenType::COMMA)) {
             auto [k, v] = parseIDEqualsValue();
-            params.emplace_back(k, std::stoi(v));
+            params.emplace_back(k, toInt(v));
         }
     }
 
@@ -369,9 +379,9 @@ std::vector<double> Parser::parseListOfNumbers() {
 
     while (!check(TokenType::RBRACKET)) {
         if (check(TokenType::INT)) {
-            values.push_back(std::stoi(advance().value));
+            values.push_back(toInt(advance().value));
         } else if (check(TokenType::FLOAT)) {
-            values.push_back(std::stod(advance().value));
+            values.push_back(toDouble(advance().value));
         } else {
             throw std::runtime_error("Expected number inside list at line " + std::to_string(peek().line));
         }
@@ -385,8 +395,8 @@ std::vector<double> Parser::parseListOfNumbers() {
     return values;
 }
 
-std::vector<std::string> Parser::parseListOfStrings() {
-    std::vector<std::string> values;
+std::vector<std::string_view> Parser::parseListOfStrings() {
+    std::vector<std::string_view> values;
 
     expect(TokenType::LBRACKET, "'['");
 
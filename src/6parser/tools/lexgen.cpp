@@ -0,0 +1,376 @@
+// Lexer table generator.
+// Combines tokenPatterns and keywordTable into one longest-match DFA, minimizes
+// it and prints it as constexpr tables for lexer.cpp.
+//
+// Build and run from src/6parser:
+//   g++ -std=c++17 -O2 tools/lexgen.cpp -o lexgen
+//   ./lexgen > include/lexer_tables.h
+#include "../include/token_patterns.h"
+#include "../../2DFA/FiniteAutomaton.hpp"
+#include <bitset>
+#include <cctype>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using ByteSet = std::bitset<256>;
+
+// One lexical rule. Rules earlier in the list win when two rules accept the
+// same longest lexeme, which is how keywords beat ID.
+struct Rule {
+    TokenType type;
+    std::string name;
+};
+
+// Glushkov (position) automaton: every byte-set leaf of a pattern is a
+// position, and the NFA has no epsilon moves, so it can be handed directly to
+// FiniteAutomaton::ConvertToDFA.
+class PositionAutomaton {
+public:
+    std::vector<ByteSet> positionBytes{ByteSet()}; // position 0 is the start
+    std::vector<int> positionRule{-1};
+    std::vector<std::set<int>> follow{{}};
+    std::set<int> startFirst;
+
+    void addPattern(std::string_view pattern, int rule) {
+        text = pattern;
+        at = 0;
+        currentRule = rule;
+        Fragment f = parseAlternation();
+        if (at != text.size()) fail("unexpected ')'");
+        if (f.nullable) fail("pattern matches the empty string");
+        startFirst.insert(f.first.begin(), f.first.end());
+        for (int p : f.last) finals.insert(p);
+    }
+
+    void addKeyword(std::string_view keyword, int rule) {
+        currentRule = rule;
+        Fragment f;
+        bool empty = true;
+        for (char c : keyword) {
+            ByteSet bytes;
+            bytes.set(static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c))));
+            bytes.set(static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c))));
+            f = concat(f, leaf(bytes), empty);
+            empty = false;
+        }
+        startFirst.insert(f.first.begin(), f.first.end());
+        for (int p : f.last) finals.insert(p);
+    }
+
+    bool isFinal(int position) const { return finals.count(position) > 0; }
+
+private:
+    struct Fragment {
+        bool nullable = true;
+        std::set<int> first, last;
+    };
+
+    std::string_view text;
+    size_t at = 0;
+    int currentRule = -1;
+    std::set<int> finals;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("pattern '" + std::string(text) + "': " + message);
+    }
+
+    Fragment leaf(const ByteSet& bytes) {
+        int p = static_cast<int>(positionBytes.size());
+        positionBytes.push_back(bytes);
+        positionRule.push_back(currentRule);
+        follow.emplace_back();
+        Fragment f;
+        f.nullable = false;
+        f.first = f.last = {p};
+        return f;
+    }
+
+    Fragment concat(const Fragment& a, const Fragment& b, bool aIsEmpty = false) {
+        if (aIsEmpty) return b;
+        for (int p : a.last) follow[p].insert(b.first.begin(), b.first.end());
+        Fragment f;
+        f.nullable = a.nullable && b.nullable;
+        f.first = a.first;
+        if (a.nullable) f.first.insert(b.first.begin(), b.first.end());
+        f.last = b.last;
+        if (b.nullable) f.last.insert(a.last.begin(), a.last.end());
+        return f;
+    }
+
+    Fragment parseAlternation() {
+        Fragment f = parseSequence();
+        while (at < text.size() && text[at] == '|') {
+            ++at;
+            Fragment g = parseSequence();
+            f.nullable = f.nullable || g.nullable;
+            f.first.insert(g.first.begin(), g.first.end());
+            f.last.insert(g.last.begin(), g.last.end());
+        }
+        return f;
+    }
+
+    Fragment parseSequence() {
+        Fragment f;
+        bool empty = true;
+        while (at < text.size() && text[at] != '|' && text[at] != ')') {
+            f = concat(f, parseRepetition(), empty);
+            empty = false;
+        }
+        return f;
+    }
+
+    Fragment parseRepetition() {
+        Fragment f = parseAtom();
+        while (at < text.size() && (text[at] == '+' || text[at] == '*' || text[at] == '?')) {
+            char op = text[at++];
+            if (op != '?')
+                for (int p : f.last) follow[p].insert(f.first.begin(), f.first.end());
+            if (op != '+') f.nullable = true;
+        }
+        return f;
+    }
+
+    Fragment parseAtom() {
+        char c = text[at++];
+        if (c == '(') {
+            Fragment f = parseAlternation();
+            if (at >= text.size() || text[at] != ')') fail("expected ')'");
+            ++at;
+            return f;
+        }
+        if (c == '[') return leaf(parseClass());
+        if (c == '\\') return leaf(parseEscape());
+        ByteSet bytes;
+        bytes.set(static_cast<unsigned char>(c));
+        return leaf(bytes);
+    }
+
+    ByteSet parseEscape() {
+        if (at >= text.size()) fail("dangling '\\'");
+        char c = text[at++];
+        ByteSet bytes;
+        switch (c) {
+            case 'd': for (char d = '0'; d <= '9'; ++d) bytes.set(static_cast<unsigned char>(d)); break;
+            case 'n': bytes.set('\n'); break;
+            case 't': bytes.set('\t'); break;
+            default: bytes.set(static_cast<unsigned char>(c)); break;
+        }
+        return bytes;
+    }
+
+    ByteSet parseClass() {
+        bool negated = at < text.size() && text[at] == '^';
+        if (negated) ++at;
+        ByteSet bytes;
+        while (at < text.size() && text[at] != ']') {
+            ByteSet item;
+            unsigned char low = static_cast<unsigned char>(text[at]);
+            if (text[at] == '\\') {
+                ++at;
+                item = parseEscape();
+            } else {
+                ++at;
+                item.set(low);
+            }
+            if (item.count() == 1 && at + 1 < text.size() && text[at] == '-' && text[at + 1] != ']') {
+                unsigned char high = static_cast<unsigned char>(text[at + 1]);
+                at += 2;
+                for (unsigned b = low; b <= high; ++b) item.set(b);
+            }
+            bytes |= item;
+        }
+        if (at >= text.size()) fail("expected ']'");
+        ++at;
+        return negated ? ~bytes : bytes;
+    }
+};
+
+std::string tokenTypeName(TokenType type) {
+    for (const auto& [keyword, keywordType] : keywordTable)
+        if (keywordType == type) return std::string(keyword);
+    switch (type) {
+        case TokenType::EQUAL: return "EQUAL";
+        case TokenType::ARROW: return "ARROW";
+        case TokenType::LBRACE: return "LBRACE";
+        case TokenType::RBRACE: return "RBRACE";
+        case TokenType::LPAREN: return "LPAREN";
+        case TokenType::RPAREN: return "RPAREN";
+        case TokenType::COMMA: return "COMMA";
+        case TokenType::LESS: return "LESS";
+        case TokenType::GREATER: return "GREATER";
+        case TokenType::EQUAL_EQUAL: return "EQUAL_EQUAL";
+        case TokenType::LESS_EQUAL: return "LESS_EQUAL";
+        case TokenType::GREATER_EQUAL: return "GREATER_EQUAL";
+        case TokenType::NOT_EQUAL: return "NOT_EQUAL";
+        case TokenType::LBRACKET: return "LBRACKET";
+        case TokenType::RBRACKET: return "RBRACKET";
+        case TokenType::DOT: return "DOT";
+        case TokenType::ID: return "ID";
+        case TokenType::STRING: return "STRING";
+        case TokenType::INT: return "INT";
+        case TokenType::FLOAT: return "FLOAT";
+        case TokenType::TIME_UNIT: return "TIME_UNIT";
+        case TokenType::INVALID: return "INVALID";
+        default: throw std::runtime_error("token type without a name");
+    }
+}
+
+// Reads the NFA positions back out of the name ConvertToDFA gives a subset
+// state, e.g. "{q3,q5,q17}".
+std::vector<int> positionsOf(const std::string& name) {
+    std::vector<int> positions;
+    for (size_t i = name.find('q'); i != std::string::npos; i = name.find('q', i + 1))
+        positions.push_back(std::stoi(name.substr(i + 1)));
+    return positions;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Rule> rules;
+    PositionAutomaton positions;
+
+    // Keywords are slotted in right before ID so they win ties against it.
+    for (const auto& [type, pattern] : tokenPatterns) {
+        if (type == TokenType::ID) {
+            for (const auto& [keyword, keywordType] : keywordTable) {
+                positions.addKeyword(keyword, static_cast<int>(rules.size()));
+                rules.push_back({keywordType, tokenTypeName(keywordType)});
+            }
+        }
+        positions.addPattern(pattern, static_cast<int>(rules.size()));
+        rules.push_back({type, tokenTypeName(type)});
+    }
+
+    // Bytes that no position tells apart share one equivalence class.
+    const size_t positionCount = positions.positionBytes.size();
+    std::map<std::vector<bool>, int> classOfSignature;
+    std::vector<int> byteClass(256);
+    std::vector<int> classByte;
+    for (int b = 0; b < 256; ++b) {
+        std::vector<bool> signature(positionCount);
+        for (size_t p = 1; p < positionCount; ++p) signature[p] = positions.positionBytes[p][b];
+        auto [it, inserted] = classOfSignature.emplace(signature, static_cast<int>(classByte.size()));
+        if (inserted) classByte.push_back(b);
+        byteClass[b] = it->second;
+    }
+    const int classCount = static_cast<int>(classByte.size());
+
+    auto stateName = [](size_t p) { return "q" + std::to_string(p); };
+    auto symbolName = [](int c) { return "c" + std::to_string(c); };
+
+    std::unordered_set<std::string> states, alphabet, finals;
+    FiniteAutomaton::TransitionMap transitions;
+    for (int c = 0; c < classCount; ++c) alphabet.insert(symbolName(c));
+    for (size_t p = 0; p < positionCount; ++p) {
+        states.insert(stateName(p));
+        if (positions.isFinal(static_cast<int>(p))) finals.insert(stateName(p));
+        const std::set<int>& next = p == 0 ? positions.startFirst : positions.follow[p];
+        for (int q : next)
+            for (int c = 0; c < classCount; ++c)
+                if (positions.positionBytes[q][classByte[c]])
+                    transitions[stateName(p)][symbolName(c)].insert(stateName(q));
+    }
+
+    FiniteAutomaton nfa(states, alphabet, transitions, stateName(0), finals);
+    FiniteAutomaton dfa = nfa.ConvertToDFA();
+
+    // Copy of the subset DFA shifted up by one, so that state 0 is a dead
+    // state for the moves ConvertToDFA leaves out. Every other state accepts
+    // the rule of highest priority among its final positions, if any.
+    const int n = static_cast<int>(dfa.StateCount()) + 1;
+    std::vector<FiniteAutomaton::SymbolId> symbolOfClass(classCount);
+    for (int c = 0; c < classCount; ++c) symbolOfClass[c] = dfa.FindSymbol(symbolName(c));
+
+    std::vector<int> accept(n, -1);
+    std::vector<std::vector<int>> delta(n, std::vector<int>(classCount, 0));
+    for (int s = 1; s < n; ++s) {
+        for (int p : positionsOf(dfa.StateName(s - 1)))
+            if (positions.isFinal(p) && (accept[s] < 0 || positions.positionRule[p] < accept[s]))
+                accept[s] = positions.positionRule[p];
+        for (int c = 0; c < classCount; ++c) {
+            FiniteAutomaton::StateId target = dfa.Next(s - 1, symbolOfClass[c]);
+            if (target != FiniteAutomaton::None) delta[s][c] = static_cast<int>(target) + 1;
+        }
+    }
+
+    // Moore partition refinement, starting from one block per accepted rule.
+    std::vector<int> block(n);
+    for (int s = 0; s < n; ++s) block[s] = accept[s] + 1;
+    for (size_t blocks = 0;;) {
+        std::map<std::vector<int>, int> blockOfSignature;
+        std::vector<int> refined(n);
+        for (int s = 0; s < n; ++s) {
+            std::vector<int> signature = {block[s]};
+            for (int c = 0; c < classCount; ++c) signature.push_back(block[delta[s][c]]);
+            refined[s] = blockOfSignature.emplace(signature, static_cast<int>(blockOfSignature.size())).first->second;
+        }
+        block = refined;
+        if (blockOfSignature.size() == blocks) break;
+        blocks = blockOfSignature.size();
+    }
+
+    // Number the minimal states canonically: dead state 0, start state 1,
+    // then breadth-first order over the byte classes.
+    const int startState = static_cast<int>(dfa.Start()) + 1;
+    std::vector<int> order;
+    std::map<int, int> numberOfBlock = {{block[0], 0}};
+    order.push_back(0);
+    std::queue<int> queue;
+    queue.push(startState);
+    numberOfBlock.emplace(block[startState], 1);
+    order.push_back(startState);
+    while (!queue.empty()) {
+        int s = queue.front();
+        queue.pop();
+        for (int c = 0; c < classCount; ++c) {
+            int t = delta[s][c];
+            if (numberOfBlock.emplace(block[t], static_cast<int>(order.size())).second) {
+                order.push_back(t);
+                queue.push(t);
+            }
+        }
+    }
+    const int minimalCount = static_cast<int>(order.size());
+    if (minimalCount > 256) throw std::runtime_error("lexer DFA no longer fits in uint8_t states");
+
+    std::cout << "#pragma once\n"
+              << "// Generated by tools/lexgen.cpp from token_patterns.h. Do not edit.\n"
+              << "// Minimal longest-match DFA over byte equivalence classes. State 0 is the\n"
+              << "// dead state; lexerAccept gives the token a state accepts, or INVALID.\n"
+              << "#include \"token.h\"\n"
+              << "#include <cstdint>\n\n"
+              << "inline constexpr int lexerStateCount = " << minimalCount << ";\n"
+              << "inline constexpr int lexerClassCount = " << classCount << ";\n"
+              << "inline constexpr std::uint8_t lexerDeadState = 0;\n"
+              << "inline constexpr std::uint8_t lexerStartState = 1;\n\n";
+
+    std::cout << "inline constexpr std::uint8_t lexerByteClass[256] = {";
+    for (int b = 0; b < 256; ++b)
+        std::cout << (b % 16 == 0 ? "\n    " : " ") << std::setw(2) << byteClass[b] << ",";
+    std::cout << "\n};\n\n";
+
+    std::cout << "inline constexpr std::uint8_t lexerTransitions[lexerStateCount][lexerClassCount] = {\n";
+    for (int s : order) {
+        std::cout << "    {";
+        for (int c = 0; c < classCount; ++c)
+            std::cout << (c ? "," : "") << std::setw(3) << numberOfBlock.at(block[delta[s][c]]);
+        std::cout << "},\n";
+    }
+    std::cout << "};\n\n";
+
+    std::cout << "inline constexpr TokenType lexerAccept[lexerStateCount] = {\n";
+    for (int s : order)
+        std::cout << "    TokenType::" << (accept[s] < 0 ? "INVALID" : rules[accept[s]].name) << ",\n";
+    std::cout << "};\n";
+    return 0;
+}